@@ -1,4 +1,9 @@
 #include "ast/abstraction_utils.hpp"
+#include <algorithm>
+#include <chrono>
+#include "ast/query_cache.hpp"
+#include "ast/query_log.hpp"
+#include "ast/query_limits.hpp"
 
 using namespace ast;
 
@@ -80,12 +85,38 @@ bool ast::equals(z3::solver& solver, const z3::expr& lhs, const z3::expr& rhs) {
 }
 
 
-bool ast::is_taut(z3::solver& solver, const z3::expr& expr) {
+z3::check_result check_taut(z3::solver& solver, const z3::expr& expr) {
+	// sat: no tautology, unsat: tautology, unknown: solver gave up (e.g. due to ast::QueryLimits)
+	// the cache does not know about assertions already made to the solver
+	bool cacheable = solver.assertions().size() == 0;
+	std::string key;
+	bool result;
+	if (cacheable) {
+		key = QueryCache::key(expr);
+		if (QueryCache::instance().lookup(key, result)) return result ? z3::unsat : z3::sat;
+	}
+
+	auto clk_begin = std::chrono::steady_clock::now();
 	solver.push();
 	solver.add(!expr);
 	auto res = solver.check();
 	solver.pop();
-	return res == z3::unsat;
+
+	QueryLog& log = QueryLog::instance();
+	if (log.enabled()) {
+		z3::expr query = !expr;
+		z3::expr_vector assertions = solver.assertions();
+		for (unsigned int i = 0; i < assertions.size(); i++) query = assertions[i] && query;
+		std::string status = res == z3::sat ? "sat" : (res == z3::unsat ? "unsat" : "unknown");
+		log.record(query, status, std::chrono::duration<double>(std::chrono::steady_clock::now() - clk_begin).count());
+	}
+
+	if (cacheable && res != z3::unknown) QueryCache::instance().store(key, res == z3::unsat);
+	return res;
+}
+
+bool ast::is_taut(z3::solver& solver, const z3::expr& expr) {
+	return check_taut(solver, expr) == z3::unsat;
 }
 
 
@@ -134,7 +165,7 @@ Expr* lit2expr(const std::vector<Predicate*>& preds, const std::pair<int, bool>&
 Expr* cube2expr(const std::vector<Predicate*>& preds, const Cube& cube) {
 	assert(cube.literals.size() > 0);
 
-	// TODO: balance result expression?
+	// balanced by Expr::simplify
 	Expr* result = lit2expr(preds, *cube.literals.begin());
 	for (auto i = ++cube.literals.begin(); i != cube.literals.end(); i++)
 		result = new BinaryExpression(log_and, result, lit2expr(preds, *i));
@@ -147,7 +178,7 @@ Expr* cubes2expr(const std::vector<Predicate*>& preds, const std::vector<Cube>&
 	if (cube_list.size() == 0)
 		return new Literal(false);
 	
-	// TODO: balance result expression?
+	// balanced by Expr::simplify
 	Expr* result = cube2expr(preds, cube_list.front());
 	for (auto it = ++cube_list.begin(); it != cube_list.end(); it++)
 		result = new BinaryExpression(log_or, result, cube2expr(preds, *it));
@@ -164,8 +195,14 @@ Expr* ast::weakest_whatsoever(const std::vector<Predicate*>& preds, z3::expr& ph
 	std::queue<Cube> work_list; // contains all cubes to explore
 	std::vector<Cube> cube_list; // contains all prime implicants of phi
 
-	if (is_taut(solver, phi)) return new Literal(true);
-	if (is_taut(solver, !phi)) return new Literal(false);
+	// queries given up by the solver count as 'does not imply'; this loses precision only
+	QueryLimits& limits = QueryLimits::instance();
+	auto res = check_taut(solver, phi);
+	if (res == z3::unsat) return new Literal(true);
+	if (res == z3::unknown) limits.abstraction_fallback();
+	res = check_taut(solver, !phi);
+	if (res == z3::unsat) return new Literal(false);
+	if (res == z3::unknown) limits.abstraction_fallback();
 
 	for (int i = 0; i < preds.size(); i++) {
 		work_list.push(Cube(i, false, preds.at(i)->z3()));
@@ -178,9 +215,14 @@ Expr* ast::weakest_whatsoever(const std::vector<Predicate*>& preds, z3::expr& ph
 		work_list.pop();
 
 		if (no_prime_implicant(cube_list, curr)) continue;
-		else if (implies(solver, curr.repr, !phi)) continue;
-		else if (implies(solver, curr.repr, phi)) cube_list.push_back(curr);
-		else {
+		auto neg = check_taut(solver, !curr.repr || !phi);
+		if (neg == z3::unsat) continue;
+		auto pos = check_taut(solver, !curr.repr || phi);
+		if (pos == z3::unsat) cube_list.push_back(curr);
+		else if (neg == z3::unknown || pos == z3::unknown) {
+			// refining a cube the solver cannot decide would most likely exceed the limits again
+			limits.abstraction_fallback();
+		} else {
 			for (int i = curr.max + 1; i < preds.size(); i++) {
 				auto lit = preds.at(i)->z3();
 				work_list.push(Cube(curr, i, false, lit));
@@ -189,12 +231,14 @@ Expr* ast::weakest_whatsoever(const std::vector<Predicate*>& preds, z3::expr& ph
 		}
 	}
 
-	auto result = cubes2expr(preds, cube_list);
-	return result;
+	// removes subsumed cubes and balances the disjunction
+	std::unique_ptr<Expr> result(cubes2expr(preds, cube_list));
+	return result->simplify();
 }
 
 Expr* ast::strongest_whatsoever(const std::vector<Predicate*>& preds, z3::expr& phi, z3::solver& solver) {
 	auto notphi = !phi;
 	auto weakest = weakest_whatsoever(preds, notphi, solver);
-	return new UnaryExpression(log_not, weakest);
+	std::unique_ptr<Expr> result(new UnaryExpression(log_not, weakest));
+	return result->simplify();
 }
@@ -37,9 +37,11 @@ namespace ast {
 
 	/**
 	 * @brief Checks whether the given formula is a tautology
+	 * @details Results are cached in ```QueryCache::instance()``` if the solver has no assertions.
+	 *          Queries actually sent to the solver are recorded in ```QueryLog::instance()```.
 	 * @param solver solver with adequate context
 	 * @param expr the expression to check
-	 * @return ```true``` iff. ```|= expr```
+	 * @return ```true``` iff. ```|= expr```; ```false``` if the solver gives up
 	 */
 	bool is_taut(z3::solver& solver, const z3::expr& expr);
 
@@ -0,0 +1,82 @@
+#include "ast/arena.hpp"
+
+#include <new>
+
+using namespace ast;
+
+
+#define ARENA_CHUNK_SIZE 65536
+#define ARENA_HEADER_SIZE alignof(std::max_align_t)
+
+
+std::size_t round_up(std::size_t size) {
+	return (size + ARENA_HEADER_SIZE - 1) / ARENA_HEADER_SIZE * ARENA_HEADER_SIZE;
+}
+
+
+/******************************************************************************
+	ARENA
+ ******************************************************************************/
+
+Arena* Arena::_current = NULL;
+
+Arena::Arena() : _used(0), _capacity(0) {}
+
+Arena::~Arena() {
+	for (char* chunk : _chunks)
+		::operator delete(chunk);
+}
+
+void* Arena::allocate(std::size_t size) {
+	size = round_up(size);
+	_allocated += size;
+
+	if (size > ARENA_CHUNK_SIZE / 4) {
+		// large objects get a chunk of their own; the current chunk is kept for bumping
+		char* chunk = static_cast<char*>(::operator new(size));
+		_chunks.insert(_chunks.end() - (_chunks.empty() ? 0 : 1), chunk);
+		return chunk;
+	}
+
+	if (_used + size > _capacity) {
+		_chunks.push_back(static_cast<char*>(::operator new(ARENA_CHUNK_SIZE)));
+		_used = 0;
+		_capacity = ARENA_CHUNK_SIZE;
+	}
+	void* result = _chunks.back() + _used;
+	_used += size;
+	return result;
+}
+
+
+/******************************************************************************
+	ARENA SCOPE
+ ******************************************************************************/
+
+ArenaScope::ArenaScope(Arena& arena) : _outer(Arena::_current) {
+	Arena::_current = &arena;
+}
+
+ArenaScope::~ArenaScope() {
+	Arena::_current = _outer;
+}
+
+
+/******************************************************************************
+	ARENA ALLOCATED
+ ******************************************************************************/
+
+void* ArenaAllocated::operator new(std::size_t size) {
+	Arena* arena = Arena::current();
+	char* base = static_cast<char*>(arena == NULL ? ::operator new(ARENA_HEADER_SIZE + size) : arena->allocate(ARENA_HEADER_SIZE + size));
+	*reinterpret_cast<Arena**>(base) = arena;
+	return base + ARENA_HEADER_SIZE;
+}
+
+void ArenaAllocated::operator delete(void* ptr) {
+	if (ptr == NULL) return;
+	char* base = static_cast<char*>(ptr) - ARENA_HEADER_SIZE;
+	// arena memory is released together with its arena
+	if (*reinterpret_cast<Arena**>(base) == NULL)
+		::operator delete(base);
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+
+namespace ast {
+
+
+	/**
+	 * @brief Region allocator for the statements and declarations of one abstraction.
+	 * @details Memory is handed out from large chunks and is never returned individually;
+	 *          deleting an object allocated in an ```Arena``` runs its destructor only.
+	 *          All chunks are released at once when the arena is destroyed, hence it must
+	 *          outlive every object allocated in it.
+	 *
+	 * @see ast::ArenaScope
+	 * @see ast::Program::abstract
+	 */
+	class Arena {
+		private:
+			std::vector<char*> _chunks;
+			std::size_t _used;
+			std::size_t _capacity;
+			std::size_t _allocated = 0;
+			static Arena* _current;
+
+		public:
+			Arena();
+			~Arena();
+			Arena(const Arena&) = delete;
+			Arena& operator=(const Arena&) = delete;
+
+			void* allocate(std::size_t size);
+			/**
+			 * @brief Number of bytes handed out by this arena.
+			 */
+			std::size_t size() const { return _allocated; }
+
+			/**
+			 * @brief The arena ```ArenaAllocated``` objects are placed in; ```NULL``` for the heap.
+			 */
+			static Arena* current() { return _current; }
+
+		friend class ArenaScope;
+	};
+
+
+	/**
+	 * @brief Places all ```ArenaAllocated``` objects created while in scope in the given arena.
+	 */
+	class ArenaScope {
+		private:
+			Arena* _outer;
+
+		public:
+			ArenaScope(Arena& arena);
+			~ArenaScope();
+	};
+
+
+	/**
+	 * @brief Base for classes whose instances are allocated in ```Arena::current``` if set.
+	 * @details Each object is prefixed by the arena it lives in, such that ```delete```
+	 *          releases heap objects only.
+	 */
+	class ArenaAllocated {
+		public:
+			static void* operator new(std::size_t size);
+			static void operator delete(void* ptr);
+	};
+
+
+}
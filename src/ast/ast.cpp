@@ -28,6 +28,24 @@ int Literal::int_value() const {
 }
 
 
+/*** symbol lookup ***/
+
+VarDef* Program::var(symbol_t symbol) const {
+	auto it = _symbol2var.find(symbol);
+	return it != _symbol2var.end() ? it->second : NULL;
+}
+
+FunDef* Program::fun(symbol_t symbol) const {
+	auto it = _symbol2fun.find(symbol);
+	return it != _symbol2fun.end() ? it->second : NULL;
+}
+
+VarDef* FunDef::var(symbol_t symbol) const {
+	auto it = _symbol2var.find(symbol);
+	return it != _symbol2var.end() ? it->second : NULL;
+}
+
+
 /*** entry2fun ***/
 
 FunDef* Program::entry2fun(symbolic::Node entry) const {
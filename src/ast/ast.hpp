@@ -1,6 +1,9 @@
 #pragma once
 
 #include <map>
+#include <set>
+#include <memory>
+#include <unordered_map>
 #include <string>
 #include <vector>
 #include <cassert>
@@ -8,6 +11,9 @@
 #include <exception>
 #include <z3++.h>
 #include "symbolic/ControlFlowGraph.hpp"
+#include "ast/arena.hpp"
+#include "ast/symbols.hpp"
+#include "ast/versions.hpp"
 
 /**
  * @brief Abstract Syntax Tree for representing a subset of C programs.
@@ -30,6 +36,7 @@ namespace ast {
 	class Ite;
 	class Call;
 	class Return;
+	class LargeBlock;
 	class ParallelAssignment;
 	class SimpleAssignment;
 	class Assume;
@@ -47,6 +54,12 @@ namespace ast {
 	class Predicate;
 	class PredicateList;
 
+	class FlowGraph;
+	class Locator;
+	class Unrolling;
+	struct Relevance;
+	class Inlining;
+
 	class Exception;
 	class ValidationError;
 	class UnsupportedOperationError;
@@ -159,21 +172,34 @@ namespace ast {
 	 */
 	class Program {
 		private:
+			std::unique_ptr<Arena> _arena; // declared first, thus released after all declarations
 			std::vector<std::unique_ptr<VarDef>> _vars;
 			std::vector<std::unique_ptr<FunDef>> _funs;
 			std::map<std::string, VarDef*> _name2var;
 			std::map<std::string, FunDef*> _name2fun;
+			std::unordered_map<symbol_t, VarDef*> _symbol2var;
+			std::unordered_map<symbol_t, FunDef*> _symbol2fun;
 
 		public:
 			Program(std::vector<VarDef*> vars, std::vector<FunDef*> funs);
 			/**
 			 * @brief Gives a mapping from available variable names to their Declaration.
 			 */
-			const std::map<std::string, VarDef*> name2var() const { return _name2var; }
+			const std::map<std::string, VarDef*>& name2var() const { return _name2var; }
 			/**
 			 * @brief Gives a mapping from available function names to their Definition.
 			 */
-			const std::map<std::string, FunDef*> name2fun() const { return _name2fun; }
+			const std::map<std::string, FunDef*>& name2fun() const { return _name2fun; }
+			/**
+			 * @brief Gives the declaration of the global variable with the given identifier.
+			 * @return the declaration; ```NULL``` if there is none
+			 */
+			VarDef* var(symbol_t symbol) const;
+			/**
+			 * @brief Gives the definition of the function with the given identifier.
+			 * @return the definition; ```NULL``` if there is none
+			 */
+			FunDef* fun(symbol_t symbol) const;
 			/**
 			 * @brief Checks whether all internal constraints are met.
 			 * @details Mandatory to call before using any other method.
@@ -198,15 +224,51 @@ namespace ast {
 			 * @see Program::validate
 			 */
 			void add_initializers();
+			/**
+			 * @brief Removes declarations and statements that cannot influence any assertion.
+			 * @details Assumes a validated program; the result is validated again.
+			 *          Assertions, assumptions and loops (which may not terminate) are kept, as are calls
+			 *          to functions that contain kept statements or that are recursive. Everything else is
+			 *          kept only if it may influence the condition of a kept statement by data or control
+			 *          dependence (cf. ```Relevance```). Kept statements are not copied; hence, a trace of
+			 *          the result is a trace of the original program once the removed statements, which
+			 *          neither block nor fail, are interleaved.
+			 * @return the number of removed statements
+			 */
+			std::size_t slice();
+			/**
+			 * @brief Excludes functions from ```Program::abstract``` (and thus from the ControlFlowGraph).
+			 * @details Assumes a validated program. Functions are excluded if they are unreachable from
+			 *          ```main``` or if they cannot have an effect on their callers, i.e. if they neither
+			 *          contain (or call) assertions, assumptions or loops, nor are recursive, nor modify
+			 *          global variables. Calls to excluded functions are dropped by the abstraction.
+			 * @return the excluded functions
+			 */
+			std::vector<const FunDef*> exclude_procedures();
+			/**
+			 * @brief Replaces calls of small non-recursive functions by copies of their bodies.
+			 * @details Assumes a validated program; the result is validated again.
+			 *          The local variables of every inlined copy are renamed to fresh locals of the
+			 *          caller. Calls inside loops are kept, also within inlined bodies, since the
+			 *          locals of a copy would not be reset between iterations.
+			 *          Functions that are not called anymore are kept (cf. ```Program::exclude_procedures```).
+			 * @see Inlining
+			 * @param threshold maximal size of inlined functions, i.e. number of edges of their FlowGraph
+			 * @return the number of inlined calls
+			 */
+			std::size_t inline_calls(std::size_t threshold);
 			/**
 			 * @brief Generates a predicate abstraction of the program.
 			 * @details This is based on the predicate abstraction described by Thomas Ball (Microsoft Research)
 			 *          in "Automatic Predicate Abstraction of C Programs" (2001)
 			 *          
 			 *          Assumes a validated program.
+			 *          The declarations and statements of the result are allocated in an ```Arena```
+			 *          owned by the result, thus they are released at once.
 			 * 
 			 * @see http://dl.acm.org/citation.cfm?id=378846
 			 * @see http://www.cs.ucla.edu/~todd/research/pldi01.pdf
+			 * 
 			 * @see Program::validate
 			 * @param pl Predicates for the abstraction
 			 * @return the abstracted program; ownership sould be claimed
@@ -215,17 +277,22 @@ namespace ast {
 			/**
 			 * @brief Translates this program into a ControlFlowGraph.
 			 * @details Assumes that this program is the result of a predicate abstraction and that it is validated.
+			 *          With a large-block encoding, every maximal sequence of assignments and assumptions
+			 *          becomes a single transition (cf. ```LargeBlock```), and identity transitions that
+			 *          merely join the sequence with the node following it are saved.
 			 * @see Program::abstract
 			 * @see Program::validate
+			 * @param large_blocks flag determining whether a large-block encoding is used
 			 * @return the corresponding ControlFlowGraph; ownership should be claimed
 			 */
-			symbolic::ControlFlowGraph* cfg();
+			symbolic::ControlFlowGraph* cfg(bool large_blocks=false);
 			FunDef* entry2fun(symbolic::Node entry) const;
 	};
 
-	class VarDef {
+	class VarDef : public ArenaAllocated {
 		private:
 			std::string _name;
+			symbol_t _symbol;
 			type_t _type;
 			std::size_t _cfg_id;
 			const Program* _prog = NULL;
@@ -233,7 +300,8 @@ namespace ast {
 
 		public:
 			VarDef(std::string name, type_t type);
-			std::string name() const { return _name; }
+			const std::string& name() const { return _name; }
+			symbol_t symbol() const { return _symbol; }
 			type_t type() const { return _type; }
 			bool is_global() const { return _prog != NULL; }
 			bool is_local() const { return _fun != NULL; }
@@ -248,29 +316,71 @@ namespace ast {
 		friend class FunDef;
 	};
 
-	class FunDef {
+	class FunDef : public ArenaAllocated {
 		private:
 			std::string _name;
+			symbol_t _symbol;
 			std::vector<std::unique_ptr<VarDef>> _vars;
 			std::vector<std::unique_ptr<Statement>> _stmts;
 			std::map<std::string, VarDef*> _name2var;
-			std::unique_ptr<symbolic::Procedure> _cfg_proc;
-			std::unique_ptr<symbolic::Node> _cfg_last;
+			std::unordered_map<symbol_t, VarDef*> _symbol2var;
+			symbolic::Procedure _cfg_proc;
+			symbolic::Node _cfg_last;
+			std::vector<std::unique_ptr<LargeBlock>> _cfg_blocks;
+			bool _excluded = false;
 
 		public:
 			FunDef(std::string name, std::vector<VarDef*> vars, std::vector<Statement*> stmts);
-			const std::map<std::string, VarDef*> name2var() const { return _name2var; }
-			std::string name() const { return _name; }
+			const std::map<std::string, VarDef*>& name2var() const { return _name2var; }
+			/**
+			 * @brief Gives the declaration of the local variable with the given identifier.
+			 * @return the declaration; ```NULL``` if there is none
+			 */
+			VarDef* var(symbol_t symbol) const;
+			const std::string& name() const { return _name; }
+			symbol_t symbol() const { return _symbol; }
+			bool is_excluded() const { return _excluded; }
 			void validate(const Program& prog);
 			void prettyprint(std::ostream& os) const;
 			void add_initializers(const Program& prog);
+			bool relevant(Relevance& relevance) const;
+			std::size_t prune(Relevance& relevance);
+			void inline_calls(Inlining& inlining);
+			std::vector<Statement*> instantiate(Inlining& inlining) const;
 			FunDef* abstract(const PredicateList& pl, z3::solver& solver, z3::context& context) const;
-			void cfg_pass_one(std::size_t& numVars, std::size_t& numBlocks, std::size_t& numProcs, std::size_t& numCalls);
+			void cfg_pass_one(std::size_t& numVars, std::size_t& numBlocks, std::size_t& numProcs, std::size_t& numCalls, bool large_blocks);
 			void cfg_pass_two(symbolic::ControlFlowGraph& cfg) const;
 			void collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const;
-			const symbolic::Procedure* cfg_procedure() const { return _cfg_proc.get(); }
+			const symbolic::Procedure* cfg_procedure() const { return &_cfg_proc; }
 			std::vector<const TraceableStatement*> flat_trace(const Program& abstract, const symbolic::ControlFlowGraph& cfg, const BDD callconf, const BDD returnconf, const BDD bounds, const BDD ignored_edges) const;
+			/**
+			 * @brief Translates the (concrete) body of this function into an explicit FlowGraph.
+			 * @details Assumes a validated program. Branch conditions and assertions are turned
+			 *          into ```Assume``` edges, failing assertions lead to ```FlowGraph::error()```.
+			 * @see FlowGraph
+			 * @return the corresponding FlowGraph; ownership should be claimed
+			 */
+			FlowGraph* flow() const;
+			/**
+			 * @brief Relates the locations of ```FunDef::flow``` to the ControlFlowGraph of an abstraction.
+			 * @details Assumes that ```abstract``` is the abstraction of this function and that its
+			 *          ControlFlowGraph has been created.
+			 * @see Locator
+			 * @param abstract the abstraction of this function
+			 * @return the correspondence of locations and nodes; ownership should be claimed
+			 */
+			Locator* locate(const FunDef& abstract) const;
+			/**
+			 * @brief Symbolically executes the (concrete) body of this function.
+			 * @details Assumes a validated program. Loops and calls are unwound as far as
+			 *          the given Unrolling permits.
+			 * @see Unrolling
+			 * @param unrolling the encoding to extend; its current state is the state on entry
+			 */
+			void unroll(Unrolling& unrolling) const;
 			// std::vector<Expr*> cfg_wp_proof(const Expr* phi, const Program& prog, const symbolic::ControlFlowGraph& cfg, const BDD preconf, const BDD postconf, const BDD bounds, const BDD ignored_edges) const;
+
+		friend class Program;
 	};
 
 
@@ -278,18 +388,38 @@ namespace ast {
 		STATEMENTS
 	 ******************************************************************************/
 
-	class Statement {
+	class Statement : public ArenaAllocated {
 		protected:
-			std::unique_ptr<symbolic::Node> _cfg_pre;
+			symbolic::Node _cfg_pre;
 
 		public:
 			virtual ~Statement() = default;
+			const symbolic::Node& cfg_pre() const { return _cfg_pre; }
 			virtual void validate(const Program& prog, const FunDef& fun) = 0;
 			virtual void prettyprint(std::ostream& os, int indent) const = 0;
 			virtual std::vector<Statement*> abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const = 0;
-			virtual symbolic::Node cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre);
+			virtual symbolic::Node cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre, bool large_blocks);
 			virtual void cfg_pass_two(symbolic::ControlFlowGraph& cfg) = 0;
 			virtual void collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const = 0;
+			virtual std::size_t flow(FlowGraph& graph, std::size_t pre) const = 0;
+			virtual std::size_t locate(Locator& locator, std::size_t pre) const = 0;
+			virtual void unroll(Unrolling& unrolling) const = 0;
+			/**
+			 * @brief Decides whether the statement must be kept by ```Program::slice```.
+			 * @details If so, the variables it depends on are added to ```relevance```.
+			 *          Nested statements are analyzed in any case.
+			 */
+			virtual bool relevant(Relevance& relevance) const = 0;
+			/**
+			 * @brief Removes the nested statements that need not be kept.
+			 * @return a statement replacing this one; ```NULL``` if there is none
+			 */
+			virtual Statement* prune(Relevance& relevance, std::size_t& removed);
+			/**
+			 * @brief Copies the statement for ```Program::inline_calls```.
+			 * @details Variables are renamed as the given Inlining demands; calls may be expanded.
+			 */
+			virtual std::vector<Statement*> instantiate(Inlining& inlining) const = 0;
 	};
 
 	class TraceableStatement : public Statement {
@@ -298,14 +428,28 @@ namespace ast {
 			virtual ~TraceableStatement() = default;
 			virtual std::vector<const TraceableStatement*> flat_trace(const Program& abstract, const symbolic::ControlFlowGraph& cfg, const BDD preconf, const BDD postconf, const BDD bounds, const BDD ignored_edges) const = 0;
 			virtual Expr* wp(const Expr& phi) const = 0;
-			virtual Expr* con(std::map<const VarDef*, std::size_t>& lvalmap) const = 0;
+			virtual Expr* con(VersionMap& lvalmap) const = 0;
+			/**
+			 * @brief Gives the guarded action of assignments and assumptions, i.e. of the statements
+			 *        a ```LargeBlock``` is composed of.
+			 */
+			virtual BDD cfg_relation(const symbolic::ControlFlowGraph& cfg) const;
+
+			/**
+			 * @brief Decides whether the statement may influence the given variables (going backwards thru a trace).
+			 * @details If so, ```relevant``` is updated to the variables the statement depends on in turn.
+			 * @param relevant the variables whose values after the statement are of interest
+			 * @return ```true``` iff. the statement must be kept
+			 */
+			virtual bool slice(std::set<const VarDef*>& relevant) const = 0;
 	};
 
 	class While : public Statement {
 		private:
 			std::unique_ptr<Expr> _cond;
 			std::vector<std::unique_ptr<Statement>> _stmts;
-			std::unique_ptr<symbolic::Node> _cfg_body_post, _cfg_post;
+			symbolic::Node _cfg_body_post, _cfg_post;
+			std::vector<std::unique_ptr<LargeBlock>> _cfg_blocks;
 
 		public:
 			While(Expr* cond, std::vector<Statement*> stmts);
@@ -313,9 +457,24 @@ namespace ast {
 			void validate(const Program& prog, const FunDef& fun);
 			virtual void prettyprint(std::ostream& os, int indent) const;
 			virtual std::vector<Statement*> abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const;
-			virtual symbolic::Node cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre);
+			virtual symbolic::Node cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre, bool large_blocks);
 			virtual void cfg_pass_two(symbolic::ControlFlowGraph& cfg);
 			virtual void collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const;
+			virtual std::size_t flow(FlowGraph& graph, std::size_t pre) const;
+			virtual std::size_t locate(Locator& locator, std::size_t pre) const;
+			virtual void unroll(Unrolling& unrolling) const;
+			/**
+			 * @brief Unrolls at most ```iterations``` iterations; the remaining ones are suspended.
+			 */
+			void unroll(Unrolling& unrolling, std::size_t iterations) const;
+			/**
+			 * @brief Unrolls one more iteration of a loop suspended by ```unroll```; the condition
+			 *        of the iteration is already assumed in the current state.
+			 */
+			void resume(Unrolling& unrolling) const;
+			virtual bool relevant(Relevance& relevance) const;
+			virtual Statement* prune(Relevance& relevance, std::size_t& removed);
+			virtual std::vector<Statement*> instantiate(Inlining& inlining) const;
 	};
 
 	class Ite : public Statement {
@@ -324,7 +483,8 @@ namespace ast {
 			std::unique_ptr<Expr> _cond;
 			std::vector<std::unique_ptr<Statement>> _if;
 			std::vector<std::unique_ptr<Statement>> _else;
-			std::unique_ptr<symbolic::Node> _cfg_if_post, _cfg_else_post, _cfg_post;
+			symbolic::Node _cfg_if_post, _cfg_else_post, _cfg_post;
+			std::vector<std::unique_ptr<LargeBlock>> _cfg_blocks;
 
 		public:
 			Ite(Expr* cond, std::vector<Statement*> ifStmts);
@@ -333,30 +493,44 @@ namespace ast {
 			void validate(const Program& prog, const FunDef& fun);
 			virtual void prettyprint(std::ostream& os, int indent) const;
 			virtual std::vector<Statement*> abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const;
-			virtual symbolic::Node cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre);
+			virtual symbolic::Node cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre, bool large_blocks);
 			virtual void cfg_pass_two(symbolic::ControlFlowGraph& cfg);
 			virtual void collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const;
+			virtual std::size_t flow(FlowGraph& graph, std::size_t pre) const;
+			virtual std::size_t locate(Locator& locator, std::size_t pre) const;
+			virtual void unroll(Unrolling& unrolling) const;
+			virtual bool relevant(Relevance& relevance) const;
+			virtual Statement* prune(Relevance& relevance, std::size_t& removed);
+			virtual std::vector<Statement*> instantiate(Inlining& inlining) const;
 	};
 
 	class Call : public TraceableStatement {
 		private:
 			std::string _funname;
+			symbol_t _funsymbol;
 			FunDef* _decl;
-			std::unique_ptr<symbolic::Call> _cfg_call;
+			symbolic::Call _cfg_call;
 			std::unique_ptr<Return> _trace_return;
 
 		public:
 			Call(std::string name);
 			Call(std::string name, const Call& trace_father);
+			const FunDef* decl() const { return _decl; }
 			void validate(const Program& prog, const FunDef& fun);
 			virtual void prettyprint(std::ostream& os, int indent) const;
 			virtual std::vector<Statement*> abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const;
-			virtual symbolic::Node cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre);
+			virtual symbolic::Node cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre, bool large_blocks);
 			virtual void cfg_pass_two(symbolic::ControlFlowGraph& cfg);
 			virtual void collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const;
+			virtual std::size_t flow(FlowGraph& graph, std::size_t pre) const;
+			virtual std::size_t locate(Locator& locator, std::size_t pre) const;
+			virtual void unroll(Unrolling& unrolling) const;
+			virtual bool relevant(Relevance& relevance) const;
+			virtual std::vector<Statement*> instantiate(Inlining& inlining) const;
 			virtual std::vector<const TraceableStatement*> flat_trace(const Program& abstract, const symbolic::ControlFlowGraph& cfg, const BDD preconf, const BDD postconf, const BDD bounds, const BDD ignored_edges) const;
 			virtual Expr* wp(const Expr& phi) const;
-			virtual Expr* con(std::map<const VarDef*, std::size_t>& lvalmap) const;
+			virtual Expr* con(VersionMap& lvalmap) const;
+			virtual bool slice(std::set<const VarDef*>& relevant) const;
 	};
 
 	class Return : public TraceableStatement {
@@ -364,26 +538,61 @@ namespace ast {
 		public:
 			virtual void validate(const Program& prog, const FunDef& fun) { assert(false); }
 			virtual void prettyprint(std::ostream& os, int indent) const;
-			virtual std::vector<Statement*> abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const { assert(false); }
-			virtual symbolic::Node cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre) { assert(false); }
+			virtual std::vector<Statement*> abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const { assert(false); return {}; }
+			virtual symbolic::Node cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre, bool large_blocks) { assert(false); return pre; }
 			virtual void cfg_pass_two(symbolic::ControlFlowGraph& cfg) { assert(false); }
 			virtual void collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const { assert(false); }
-			virtual std::vector<const TraceableStatement*> flat_trace(const Program& abstract, const symbolic::ControlFlowGraph& cfg, const BDD preconf, const BDD postconf, const BDD bounds, const BDD ignored_edges) const { assert(false); }
+			virtual std::size_t flow(FlowGraph& graph, std::size_t pre) const { assert(false); return pre; }
+			virtual std::size_t locate(Locator& locator, std::size_t pre) const { assert(false); return pre; }
+			virtual void unroll(Unrolling& unrolling) const { assert(false); }
+			virtual bool relevant(Relevance& relevance) const { assert(false); return false; }
+			virtual std::vector<Statement*> instantiate(Inlining& inlining) const { assert(false); return {}; }
+			virtual std::vector<const TraceableStatement*> flat_trace(const Program& abstract, const symbolic::ControlFlowGraph& cfg, const BDD preconf, const BDD postconf, const BDD bounds, const BDD ignored_edges) const { assert(false); return {}; }
 			virtual Expr* wp(const Expr& phi) const;
-			virtual Expr* con(std::map<const VarDef*, std::size_t>& lvalmap) const;
+			virtual Expr* con(VersionMap& lvalmap) const;
+			virtual bool slice(std::set<const VarDef*>& relevant) const;
+	};
+
+	class LargeBlock : public TraceableStatement {
+		// this is a sequence of assignments and assumptions taken as a single CFG transition (cf. Program::cfg);
+		// it must not occure in program code!
+		private:
+			std::vector<const TraceableStatement*> _stmts;
+			symbolic::Node _cfg_post;
+
+		public:
+			LargeBlock(std::vector<const TraceableStatement*> stmts, symbolic::Node pre, symbolic::Node post);
+			const std::vector<const TraceableStatement*>& statements() const { return _stmts; }
+			virtual void validate(const Program& prog, const FunDef& fun) { assert(false); }
+			virtual void prettyprint(std::ostream& os, int indent) const { assert(false); }
+			virtual std::vector<Statement*> abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const { assert(false); return {}; }
+			virtual symbolic::Node cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre, bool large_blocks) { assert(false); return pre; }
+			virtual void cfg_pass_two(symbolic::ControlFlowGraph& cfg);
+			virtual void collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const;
+			virtual std::size_t flow(FlowGraph& graph, std::size_t pre) const { assert(false); return pre; }
+			virtual std::size_t locate(Locator& locator, std::size_t pre) const { assert(false); return pre; }
+			virtual void unroll(Unrolling& unrolling) const { assert(false); }
+			virtual bool relevant(Relevance& relevance) const { assert(false); return false; }
+			virtual std::vector<Statement*> instantiate(Inlining& inlining) const { assert(false); return {}; }
+			virtual std::vector<const TraceableStatement*> flat_trace(const Program& abstract, const symbolic::ControlFlowGraph& cfg, const BDD preconf, const BDD postconf, const BDD bounds, const BDD ignored_edges) const;
+			virtual Expr* wp(const Expr& phi) const { assert(false); return NULL; }
+			virtual Expr* con(VersionMap& lvalmap) const { assert(false); return NULL; }
+			virtual bool slice(std::set<const VarDef*>& relevant) const { assert(false); return false; }
 	};
 
 	class Assignment : public TraceableStatement {
 		// TODO: remove SimpleAssignment,ParallelAssignment,Skip in favour of a super-duper Assignment
 		protected:
-			std::unique_ptr<symbolic::Node> _cfg_post;
+			symbolic::Node _cfg_post;
 			const Assignment* _trace_stmt = NULL; // points to the assignment statement which created "this" during abstraction
 
 		public:
 			Assignment();
 			Assignment(const Assignment* trace_father);
-			virtual symbolic::Node cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre);
+			virtual symbolic::Node cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre, bool large_blocks);
 			virtual void collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const;
+			virtual std::size_t flow(FlowGraph& graph, std::size_t pre) const;
+			virtual std::size_t locate(Locator& locator, std::size_t pre) const;
 			virtual std::vector<const TraceableStatement*> flat_trace(const Program& abstract, const symbolic::ControlFlowGraph& cfg, const BDD preconf, const BDD postconf, const BDD bounds, const BDD ignored_edges) const;
 	};
 
@@ -399,8 +608,14 @@ namespace ast {
 			virtual void prettyprint(std::ostream& os, int indent) const;
 			virtual std::vector<Statement*> abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const;
 			virtual void cfg_pass_two(symbolic::ControlFlowGraph& cfg);
+			virtual BDD cfg_relation(const symbolic::ControlFlowGraph& cfg) const;
 			virtual Expr* wp(const Expr& phi) const;
-			virtual Expr* con(std::map<const VarDef*, std::size_t>& lvalmap) const;
+			virtual Expr* con(VersionMap& lvalmap) const;
+			virtual bool slice(std::set<const VarDef*>& relevant) const;
+			virtual void unroll(Unrolling& unrolling) const;
+			virtual bool relevant(Relevance& relevance) const;
+			virtual Statement* prune(Relevance& relevance, std::size_t& removed);
+			virtual std::vector<Statement*> instantiate(Inlining& inlining) const;
 	};
 
 	class SimpleAssignment : public Assignment {
@@ -415,27 +630,37 @@ namespace ast {
 			virtual void prettyprint(std::ostream& os, int indent) const;
 			virtual std::vector<Statement*> abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const;
 			virtual void cfg_pass_two(symbolic::ControlFlowGraph& cfg);
+			virtual BDD cfg_relation(const symbolic::ControlFlowGraph& cfg) const;
 			virtual Expr* wp(const Expr& phi) const;
-			virtual Expr* con(std::map<const VarDef*, std::size_t>& lvalmap) const;
+			virtual Expr* con(VersionMap& lvalmap) const;
+			virtual bool slice(std::set<const VarDef*>& relevant) const;
+			virtual void unroll(Unrolling& unrolling) const;
+			virtual bool relevant(Relevance& relevance) const;
+			virtual std::vector<Statement*> instantiate(Inlining& inlining) const;
 	};
 
 	class AssBase : public TraceableStatement {
 		protected:
 			std::unique_ptr<Expr> _expr;
 			std::string _name;
-			std::unique_ptr<symbolic::Node> _cfg_post;
+			symbolic::Node _cfg_post;
 			std::unique_ptr<AssBase> _trace_stmt; // assume from an if/while abstraction
 
 		public:
 			AssBase(Expr* expr, std::string name);
 			AssBase(Expr* expr, std::string name, AssBase* trace_father);
+			const Expr* expr() const { return _expr.get(); }
 			virtual void validate(const Program& prog, const FunDef& fun);
 			virtual void prettyprint(std::ostream& os, int indent) const;
 			virtual std::vector<Statement*> abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const = 0;
-			virtual symbolic::Node cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre);
+			virtual symbolic::Node cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre, bool large_blocks);
 			virtual void cfg_pass_two(symbolic::ControlFlowGraph& cfg);
+			virtual BDD cfg_relation(const symbolic::ControlFlowGraph& cfg) const;
 			virtual void collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const;
+			virtual std::size_t flow(FlowGraph& graph, std::size_t pre) const;
+			virtual std::size_t locate(Locator& locator, std::size_t pre) const;
 			virtual std::vector<const TraceableStatement*> flat_trace(const Program& abstract, const symbolic::ControlFlowGraph& cfg, const BDD preconf, const BDD postconf, const BDD bounds, const BDD ignored_edges) const;
+			virtual bool relevant(Relevance& relevance) const;
 	};
 
 	class Assume : public AssBase {
@@ -444,7 +669,10 @@ namespace ast {
 			Assume(Expr* expr, Expr* trace_father_expr);
 			virtual std::vector<Statement*> abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const;
 			virtual Expr* wp(const Expr& phi) const;
-			virtual Expr* con(std::map<const VarDef*, std::size_t>& lvalmap) const;
+			virtual Expr* con(VersionMap& lvalmap) const;
+			virtual bool slice(std::set<const VarDef*>& relevant) const;
+			virtual void unroll(Unrolling& unrolling) const;
+			virtual std::vector<Statement*> instantiate(Inlining& inlining) const;
 	};
 
 	class Assert : public AssBase {
@@ -454,8 +682,13 @@ namespace ast {
 			virtual std::vector<Statement*> abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const;
 			virtual void cfg_pass_two(symbolic::ControlFlowGraph& cfg);
 			virtual void collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const;
+			virtual std::size_t flow(FlowGraph& graph, std::size_t pre) const;
+			virtual std::size_t locate(Locator& locator, std::size_t pre) const;
+			virtual void unroll(Unrolling& unrolling) const;
+			virtual std::vector<Statement*> instantiate(Inlining& inlining) const;
 			virtual Expr* wp(const Expr& phi) const;
-			virtual Expr* con(std::map<const VarDef*, std::size_t>& lvalmap) const;
+			virtual Expr* con(VersionMap& lvalmap) const;
+			virtual bool slice(std::set<const VarDef*>& relevant) const;
 	};
 
 	class Skip : public Assignment {
@@ -466,8 +699,14 @@ namespace ast {
 			virtual void prettyprint(std::ostream& os, int indent) const;
 			virtual std::vector<Statement*> abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const;
 			virtual void cfg_pass_two(symbolic::ControlFlowGraph& cfg);
+			virtual BDD cfg_relation(const symbolic::ControlFlowGraph& cfg) const;
+			virtual std::size_t locate(Locator& locator, std::size_t pre) const;
 			virtual Expr* wp(const Expr& phi) const;
-			virtual Expr* con(std::map<const VarDef*, std::size_t>& lvalmap) const;
+			virtual Expr* con(VersionMap& lvalmap) const;
+			virtual bool slice(std::set<const VarDef*>& relevant) const;
+			virtual void unroll(Unrolling& unrolling) const;
+			virtual bool relevant(Relevance& relevance) const;
+			virtual std::vector<Statement*> instantiate(Inlining& inlining) const;
 	};
 
 	class DocString : public Statement {
@@ -482,6 +721,11 @@ namespace ast {
 			virtual std::vector<Statement*> abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const;
 			virtual void cfg_pass_two(symbolic::ControlFlowGraph& cfg);
 			virtual void collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const;
+			virtual std::size_t flow(FlowGraph& graph, std::size_t pre) const;
+			virtual std::size_t locate(Locator& locator, std::size_t pre) const;
+			virtual void unroll(Unrolling& unrolling) const;
+			virtual bool relevant(Relevance& relevance) const;
+			virtual std::vector<Statement*> instantiate(Inlining& inlining) const;
 	};
 
 
@@ -489,49 +733,111 @@ namespace ast {
 		EXPRESSIONS
 	 ******************************************************************************/
 
+	/**
+	 * @brief Base class of expressions.
+	 * @details Subexpressions are hash-consed: every child is interned (cf. ```Expr::intern```), i.e.
+	 *          structurally equal subexpressions are the same node, shared between all expressions
+	 *          containing them. Hence, comparing expressions only compares their roots, copying an
+	 *          expression only copies its root, and ```Expr::replace``` only rebuilds the paths to
+	 *          replaced variables. Interned nodes are immutable; ```validate``` validates copies of
+	 *          the children and interns those instead.
+	 *
+	 *          Every node summarizes its free variables, its scope and whether it is well scoped
+	 *          when it is constructed (and again when it is validated, as declarations become known).
+	 *          Thus, the corresponding queries take constant time.
+	 */
 	class Expr {
 		protected:
 			type_t _type;
 			int _precedence;
+			std::size_t _hash; // structural; set by the constructors of the subclasses
+			SymbolSet _vars; // free variables, incl. ignored ones
+			const FunDef* _scope = NULL; // function of some local variable; NULL if there is none
+			bool _well_scoped = true; // no local variables of different functions
+			bool _ignored_vars = false;
+
+			void summarize(std::initializer_list<const Expr*> children);
+			/**
+			 * @brief The interned node structurally equal to ```expr```; ```expr``` is deleted if there is one already.
+			 */
+			static std::shared_ptr<Expr> intern(Expr* expr);
+			static void validate_child(std::shared_ptr<Expr>& child, const Program& prog, const FunDef& fun);
 
 		public:
+			typedef std::unordered_map<const Expr*, std::pair<std::shared_ptr<Expr>, std::shared_ptr<Expr>>> ReplaceCache; // node -> (node, result); keeps the node alive
+			typedef std::unordered_map<symbol_t, const Expr*> Substitution; // variable identifier -> replacement
+
 			Expr(type_t type, int precedence);
 			virtual ~Expr() = default;
 			type_t type() const { return _type; }
 			int precedence() const { return _precedence; }
+			std::size_t hash() const { return _hash; }
+			/**
+			 * @brief Structural equality; takes constant time as the children are interned.
+			 */
+			bool equals(const Expr& other) const;
+			virtual bool equals_node(const Expr& other) const = 0; // other is of the same class
 			virtual void validate(const Program& prog, const FunDef& fun) = 0;
 			virtual void prettyprint(std::ostream& os) const = 0;
 			virtual Expr* copy() const = 0;
-			virtual Expr* replace(const std::map<std::string, const Expr*>& repl) const = 0;
-			virtual bool contains(std::string varname) const = 0;
-			virtual bool contains_any_var() const = 0;
-			virtual bool contains_ignored_var() const = 0;
-			virtual const FunDef* scope() const = 0;
+			Expr* replace(const Substitution& repl) const;
+			/**
+			 * @brief Like ```replace(repl)```, but reuses the subexpressions that ```cache``` rebuilt for
+			 *        earlier calls with the same substitution.
+			 */
+			Expr* replace(const Substitution& repl, ReplaceCache& cache) const;
+			static std::shared_ptr<Expr> replace(const std::shared_ptr<Expr>& expr, const Substitution& repl, ReplaceCache& cache);
+			virtual Expr* rebuild(const Substitution& repl, ReplaceCache& cache) const = 0; // NULL if unchanged
+			/**
+			 * @brief Renames variables into the ```SymbolicConstant``` s of their current versions.
+			 * @details Variables without a version and ignored ones are kept.
+			 * @see TraceableStatement::con
+			 */
+			Expr* ssa(const VersionMap& versions) const;
+			static std::shared_ptr<Expr> ssa(const std::shared_ptr<Expr>& expr, const VersionMap& versions, ReplaceCache& cache);
+			virtual Expr* rebuild(const VersionMap& versions, ReplaceCache& cache) const = 0; // NULL if unchanged
+			/**
+			 * @brief Rewrites the expression into an equivalent, usually smaller one.
+			 * @details Folds constants, removes double negations as well as neutral, duplicate and absorbed
+			 *          operands of conjunctions and disjunctions (e.g. subsumed cubes), and balances chains
+			 *          of conjunctions and disjunctions.
+			 */
+			Expr* simplify() const;
+			static std::shared_ptr<Expr> simplify(const std::shared_ptr<Expr>& expr, ReplaceCache& cache);
+			virtual std::shared_ptr<Expr> simplified(ReplaceCache& cache) const = 0; // NULL if unchanged
+			bool contains(symbol_t var) const { return _vars.contains(var); }
+			bool contains_any(const SymbolSet& vars) const { return _vars.intersects(vars); }
+			bool contains_any_var() const { return !_vars.empty(); }
+			bool contains_ignored_var() const { return _ignored_vars; }
+			const SymbolSet& vars() const { return _vars; }
+			const FunDef* scope() const { return _scope; }
+			bool is_well_scoped() const { return _well_scoped; }
 			virtual z3::expr z3(z3::context& context) const = 0;
 			virtual BDD cfg(const symbolic::ControlFlowGraph& cfg) const = 0;
 			virtual void collect_potential_predicates(std::vector<Expr*>& collection) const = 0; // TODO: remove
 			virtual Expr* push_ignore() const = 0;
 			virtual Expr* pop_ignore() const = 0;
-			virtual bool is_well_scoped() const = 0;
 			virtual Expr* postprocess_interpolant(const Program& prog) const = 0;
+			virtual void collect_vars(std::set<const VarDef*>& vars) const = 0;
 	};
 
 	class Conditional : public Expr {
 		private:
-			std::unique_ptr<Expr> _cond;
-			std::unique_ptr<Expr> _if;
-			std::unique_ptr<Expr> _else;
+			std::shared_ptr<Expr> _cond;
+			std::shared_ptr<Expr> _if;
+			std::shared_ptr<Expr> _else;
+			Conditional(std::shared_ptr<Expr> cond, std::shared_ptr<Expr> yes, std::shared_ptr<Expr> no);
+			void rehash();
 
 		public:
 			Conditional(Expr* cond, Expr* yes, Expr* no);
 			void validate(const Program& prog, const FunDef& fun);
 			virtual void prettyprint(std::ostream& os) const;
 			virtual Conditional* copy() const;
-			virtual Expr* replace(const std::map<std::string, const Expr*>& repl) const;
-			virtual bool contains(std::string varname) const;
-			virtual bool contains_any_var() const;
-			virtual bool contains_ignored_var() const;
-			virtual const FunDef* scope() const;
+			virtual bool equals_node(const Expr& other) const;
+			virtual Expr* rebuild(const Substitution& repl, ReplaceCache& cache) const;
+			virtual Expr* rebuild(const VersionMap& versions, ReplaceCache& cache) const;
+			virtual std::shared_ptr<Expr> simplified(ReplaceCache& cache) const;
 			virtual z3::expr z3(z3::context& context) const;
 			virtual BDD cfg(const symbolic::ControlFlowGraph& cfg) const;
 			const Expr* guard() const { return _cond.get(); }
@@ -540,57 +846,65 @@ namespace ast {
 			virtual void collect_potential_predicates(std::vector<Expr*>& collection) const;
 			virtual Expr* push_ignore() const;
 			virtual Expr* pop_ignore() const;
-			virtual bool is_well_scoped() const;
 			virtual Expr* postprocess_interpolant(const Program& prog) const;
+			virtual void collect_vars(std::set<const VarDef*>& vars) const;
 	};
 
 	class UnaryExpression : public Expr {
 		private:
 			unary_op _op;
-			std::unique_ptr<Expr> _child;
+			std::shared_ptr<Expr> _child;
+			UnaryExpression(const unary_op& op, std::shared_ptr<Expr> child);
+			void rehash();
 
 		public:
 			UnaryExpression(const unary_op& op, Expr* child);
 			void validate(const Program& prog, const FunDef& fun);
 			virtual void prettyprint(std::ostream& os) const;
 			virtual UnaryExpression* copy() const;
-			virtual Expr* replace(const std::map<std::string, const Expr*>& repl) const;
-			virtual bool contains(std::string varname) const;
-			virtual bool contains_any_var() const;
-			virtual bool contains_ignored_var() const;
-			virtual const FunDef* scope() const;
+			unary_op op() const { return _op; }
+			const Expr* child() const { return _child.get(); }
+			virtual bool equals_node(const Expr& other) const;
+			virtual Expr* rebuild(const Substitution& repl, ReplaceCache& cache) const;
+			virtual Expr* rebuild(const VersionMap& versions, ReplaceCache& cache) const;
+			virtual std::shared_ptr<Expr> simplified(ReplaceCache& cache) const;
 			virtual z3::expr z3(z3::context& context) const;
 			virtual BDD cfg(const symbolic::ControlFlowGraph& cfg) const;
 			virtual void collect_potential_predicates(std::vector<Expr*>& collection) const;
 			virtual Expr* push_ignore() const;
 			virtual Expr* pop_ignore() const;
-			virtual bool is_well_scoped() const;
 			virtual Expr* postprocess_interpolant(const Program& prog) const;
+			virtual void collect_vars(std::set<const VarDef*>& vars) const;
 	};
 
 	class BinaryExpression : public Expr {
 		private:
 			binary_op _op;
-			std::unique_ptr<Expr> _left;
-			std::unique_ptr<Expr> _right;
+			std::shared_ptr<Expr> _left;
+			std::shared_ptr<Expr> _right;
+			BinaryExpression(const binary_op& op, std::shared_ptr<Expr> left, std::shared_ptr<Expr> right);
+			void rehash();
+			static void flatten(const binary_op& op, const std::shared_ptr<Expr>& expr, std::vector<std::shared_ptr<Expr>>& operands);
+			static void collect(const binary_op& op, const std::shared_ptr<Expr>& expr, ReplaceCache& cache, std::vector<std::shared_ptr<Expr>>& operands);
+			static std::shared_ptr<Expr> balance(const binary_op& op, const std::vector<std::shared_ptr<Expr>>& operands, std::size_t begin, std::size_t end);
+			std::shared_ptr<Expr> simplified_junction(ReplaceCache& cache) const;
 
 		public:
 			BinaryExpression(const binary_op& op, Expr* left, Expr* right);
 			void validate(const Program& prog, const FunDef& fun);
 			virtual void prettyprint(std::ostream& os) const;
 			virtual BinaryExpression* copy() const;
-			virtual Expr* replace(const std::map<std::string, const Expr*>& repl) const;
-			virtual bool contains(std::string varname) const;
-			virtual bool contains_any_var() const;
-			virtual bool contains_ignored_var() const;
-			virtual const FunDef* scope() const;
+			virtual bool equals_node(const Expr& other) const;
+			virtual Expr* rebuild(const Substitution& repl, ReplaceCache& cache) const;
+			virtual Expr* rebuild(const VersionMap& versions, ReplaceCache& cache) const;
+			virtual std::shared_ptr<Expr> simplified(ReplaceCache& cache) const;
 			virtual z3::expr z3(z3::context& context) const;
 			virtual BDD cfg(const symbolic::ControlFlowGraph& cfg) const;
 			virtual void collect_potential_predicates(std::vector<Expr*>& collection) const;
 			virtual Expr* push_ignore() const;
 			virtual Expr* pop_ignore() const;
-			virtual bool is_well_scoped() const;
 			virtual Expr* postprocess_interpolant(const Program& prog) const;
+			virtual void collect_vars(std::set<const VarDef*>& vars) const;
 	};
 
 	class Literal : public Expr {
@@ -606,47 +920,50 @@ namespace ast {
 			void validate(const Program& prog, const FunDef& fun);
 			virtual void prettyprint(std::ostream& os) const;
 			virtual Literal* copy() const;
-			virtual Expr* replace(const std::map<std::string, const Expr*>& repl) const;
-			virtual bool contains(std::string varname) const;
-			virtual bool contains_any_var() const;
-			virtual bool contains_ignored_var() const;
-			virtual const FunDef* scope() const;
+			virtual bool equals_node(const Expr& other) const;
+			virtual Expr* rebuild(const Substitution& repl, ReplaceCache& cache) const;
+			virtual Expr* rebuild(const VersionMap& versions, ReplaceCache& cache) const;
+			virtual std::shared_ptr<Expr> simplified(ReplaceCache& cache) const;
 			virtual z3::expr z3(z3::context& context) const;
 			virtual BDD cfg(const symbolic::ControlFlowGraph& cfg) const;
 			virtual void collect_potential_predicates(std::vector<Expr*>& collection) const;
 			virtual Expr* push_ignore() const;
 			virtual Expr* pop_ignore() const;
-			virtual bool is_well_scoped() const;
 			virtual Expr* postprocess_interpolant(const Program& prog) const;
+			virtual void collect_vars(std::set<const VarDef*>& vars) const;
 	};
 
 	class VarName : public Literal {
 		private:
+			symbol_t _symbol;
 			const /*TODO:change to const correct?*/ VarDef* _decl;
 			std::size_t _ignore_replace; // replace() has an effect iff. _ignore_replace == 0
+			VarName(const VarName* cp, std::size_t ignore_replace);
+			void rehash();
+			void summarize();
 
 		public:
 			VarName(const VarName& cp);
 			VarName(const VarName* cp);
 			VarName(std::string varname);
 			VarName(const VarDef* def);
-			std::string name() const { return _value; }
+			const std::string& name() const { return SymbolTable::instance().name(_symbol); }
+			symbol_t symbol() const { return _symbol; }
 			const VarDef* decl() const { return _decl; }
 			void validate(const Program& prog, const FunDef& fun);
 			virtual VarName* copy() const;
-			virtual Expr* replace(const std::map<std::string, const Expr*>& repl) const;
-			virtual bool contains(std::string varname) const;
-			virtual bool contains_any_var() const;
-			virtual bool contains_ignored_var() const;
-			virtual const FunDef* scope() const;
+			virtual bool equals_node(const Expr& other) const;
+			virtual Expr* rebuild(const Substitution& repl, ReplaceCache& cache) const;
+			virtual Expr* rebuild(const VersionMap& versions, ReplaceCache& cache) const;
+			virtual std::shared_ptr<Expr> simplified(ReplaceCache& cache) const;
 			virtual z3::expr z3(z3::context& context) const;
 			virtual BDD cfg(const symbolic::ControlFlowGraph& cfg) const;
 			virtual void collect_potential_predicates(std::vector<Expr*>& collection) const;
 			virtual Expr* push_ignore() const;
 			virtual Expr* pop_ignore() const;
-			virtual bool is_well_scoped() const;
 			virtual void prettyprint(std::ostream& os) const;
 			virtual Expr* postprocess_interpolant(const Program& prog) const;
+			virtual void collect_vars(std::set<const VarDef*>& vars) const;
 	};
 
 	class Unknown : public Literal {
@@ -654,18 +971,17 @@ namespace ast {
 			Unknown();
 			void validate(const Program& prog, const FunDef& fun);
 			virtual Unknown* copy() const;
-			virtual Expr* replace(const std::map<std::string, const Expr*>& repl) const;
-			virtual bool contains(std::string varname) const;
-			virtual bool contains_any_var() const;
-			virtual bool contains_ignored_var() const;
-			virtual const FunDef* scope() const;
+			virtual bool equals_node(const Expr& other) const;
+			virtual Expr* rebuild(const Substitution& repl, ReplaceCache& cache) const;
+			virtual Expr* rebuild(const VersionMap& versions, ReplaceCache& cache) const;
+			virtual std::shared_ptr<Expr> simplified(ReplaceCache& cache) const;
 			virtual z3::expr z3(z3::context& context) const;
 			virtual BDD cfg(const symbolic::ControlFlowGraph& cfg) const;
 			virtual void collect_potential_predicates(std::vector<Expr*>& collection) const;
 			virtual Expr* push_ignore() const;
 			virtual Expr* pop_ignore() const;
-			virtual bool is_well_scoped() const;
 			virtual Expr* postprocess_interpolant(const Program& prog) const;
+			virtual void collect_vars(std::set<const VarDef*>& vars) const;
 	};
 
 	class SymbolicConstant : public Literal {
@@ -680,18 +996,17 @@ namespace ast {
 			std::size_t num() const { return _num; }
 			virtual void prettyprint(std::ostream& os) const;
 			virtual SymbolicConstant* copy() const;
-			virtual Expr* replace(const std::map<std::string, const Expr*>& repl) const;
-			virtual bool contains(std::string varname) const;
-			virtual bool contains_any_var() const;
-			virtual bool contains_ignored_var() const;
-			virtual const FunDef* scope() const;
+			virtual bool equals_node(const Expr& other) const;
+			virtual Expr* rebuild(const Substitution& repl, ReplaceCache& cache) const;
+			virtual Expr* rebuild(const VersionMap& versions, ReplaceCache& cache) const;
+			virtual std::shared_ptr<Expr> simplified(ReplaceCache& cache) const;
 			virtual z3::expr z3(z3::context& context) const;
 			virtual BDD cfg(const symbolic::ControlFlowGraph& cfg) const;
 			virtual void collect_potential_predicates(std::vector<Expr*>& collection) const;
 			virtual Expr* push_ignore() const;
 			virtual Expr* pop_ignore() const;
-			virtual bool is_well_scoped() const;
 			virtual Expr* postprocess_interpolant(const Program& prog) const;
+			virtual void collect_vars(std::set<const VarDef*>& vars) const;
 	};
 
 
@@ -739,26 +1054,302 @@ namespace ast {
 	};
 
 
+	/******************************************************************************
+		SLICING
+	 ******************************************************************************/
+
+	/**
+	 * @brief Dependences of the assertions of a program as computed by ```Program::slice```.
+	 * @details Variables are relevant if they may influence the condition of an assertion (or of
+	 *          some other kept statement) by data or control dependence, also through calls.
+	 *          Functions are relevant if they have to be kept. The analysis is flow-insensitive:
+	 *          all statements are analyzed over and over again until nothing changes anymore.
+	 */
+	struct Relevance {
+		std::set<const VarDef*> vars;
+		std::set<const FunDef*> funs;
+		std::map<const FunDef*, std::set<const FunDef*>> calls; // call graph
+		const FunDef* current = NULL; // function being analyzed
+	};
+
+
+	/******************************************************************************
+		INLINING
+	 ******************************************************************************/
+
+	/**
+	 * @brief Expansion of calls as performed by ```Program::inline_calls```.
+	 * @details A function is inlined if it is neither ```main``` nor recursive and if its FlowGraph
+	 *          has at most ```threshold``` edges; calls nested in a loop are kept. Inlined bodies are
+	 *          expanded recursively. While a body is copied, its local variables are renamed to fresh
+	 *          locals of the function the copy is placed in; locals named like a global variable are
+	 *          kept (they denote the global anyway).
+	 * @see Statement::instantiate
+	 */
+	class Inlining {
+		private:
+			struct Frame {
+				Expr::Substitution renaming;
+				std::vector<std::unique_ptr<VarName>> names;
+				mutable Expr::ReplaceCache renamed; // shared subexpressions of the callee are renamed once per copy
+			};
+
+			const Program& _prog;
+			std::set<const FunDef*> _inlinable;
+			std::map<const FunDef*, std::set<const FunDef*>> _calls;
+			const FunDef* _caller = NULL;
+			std::vector<VarDef*> _locals;
+			std::vector<Frame> _stack;
+			std::size_t _count = 0;
+			std::size_t _loops = 0; // nesting depth of loops around the statement being copied
+
+			std::string fresh(const FunDef& callee, const VarDef& local) const;
+
+		public:
+			Inlining(const Program& prog, std::size_t threshold);
+			/**
+			 * @brief Number of calls expanded so far.
+			 */
+			std::size_t count() const { return _count; }
+			bool inlinable(const FunDef* fun) const { return _inlinable.count(fun) > 0; }
+			/**
+			 * @brief Decides whether ```fun``` calls some inlinable function.
+			 */
+			bool expands(const FunDef* fun) const;
+			/**
+			 * @brief Starts copying the body of ```caller```; the locals created meanwhile belong to it.
+			 */
+			void enter(const FunDef& caller);
+			/**
+			 * @brief Finishes copying the body of the current caller.
+			 * @return the fresh locals to be added to the caller; ownership should be claimed
+			 */
+			std::vector<VarDef*> leave();
+			/**
+			 * @brief Copies the body of ```callee``` for a call of the current caller.
+			 */
+			std::vector<Statement*> expand(const FunDef& callee);
+			void enter_loop() { _loops++; }
+			void leave_loop() { assert(_loops > 0); _loops--; }
+			/**
+			 * @brief Decides whether the statement being copied is nested in a loop; calls there are kept.
+			 */
+			bool in_loop() const { return _loops > 0; }
+			Expr* rename(const Expr& expr) const;
+			VarName* rename(const VarName& var) const;
+	};
+
+
+	/******************************************************************************
+		FLOW GRAPHS
+	 ******************************************************************************/
+
+	/**
+	 * @brief Explicit control flow of a single function of a (concrete) program.
+	 * @details Locations are plain numbers, every edge is labeled with the statement
+	 *          that is executed when following it. Calls are labeled with the ```Call```
+	 *          statement itself, i.e. they are not expanded.
+	 *          Statements that have to be synthesized (e.g. ```Assume```s for branch
+	 *          conditions) are owned by the graph.
+	 * @see FunDef::flow
+	 */
+	class FlowGraph {
+		public:
+			struct Edge {
+				std::size_t src;
+				std::size_t dst;
+				const TraceableStatement* stmt;
+			};
+
+		private:
+			std::size_t _size = 3;
+			std::vector<Edge> _edges;
+			std::vector<std::unique_ptr<TraceableStatement>> _ownership;
+
+		public:
+			std::size_t entry() const { return 0; }
+			std::size_t exit() const { return 1; }
+			std::size_t error() const { return 2; }
+			std::size_t size() const { return _size; }
+			std::size_t add_location() { return _size++; }
+			void add_edge(std::size_t src, std::size_t dst, const TraceableStatement* stmt);
+			const TraceableStatement* own(TraceableStatement* stmt);
+			const std::vector<Edge>& edges() const { return _edges; }
+			std::vector<const Edge*> outgoing(std::size_t loc) const;
+	};
+
+	/**
+	 * @brief Correspondence between the locations of a FlowGraph and the nodes of the
+	 *        ControlFlowGraph of an abstraction of the same function.
+	 * @details A function is walked alongside its abstraction creating locations in the very
+	 *          order ```FunDef::flow``` does. Every location is mapped to the node the abstraction
+	 *          is in at that point; hence, the configurations reachable at that node describe
+	 *          the states reachable at the location.
+	 * @see FunDef::locate
+	 * @see FunDef::flow
+	 * @see Program::abstract
+	 */
+	class Locator {
+		private:
+			struct Frame {
+				const std::vector<std::unique_ptr<Statement>>* stmts;
+				std::size_t index;
+				const symbolic::Node* end;
+			};
+
+			std::size_t _size = 0;
+			std::map<std::size_t, symbolic::Node> _nodes;
+			std::vector<Frame> _stack;
+
+		public:
+			std::size_t size() const { return _size; }
+			const symbolic::Node& node(std::size_t loc) const { return _nodes.at(loc); }
+			/**
+			 * @brief Adds a location corresponding to the current node of the abstraction.
+			 */
+			std::size_t add_location() { return add_location(current()); }
+			std::size_t add_location(const symbolic::Node& node);
+			/**
+			 * @brief Starts walking the given sequence of abstract statements; ```end``` is the node reached after the last one.
+			 */
+			void enter(const std::vector<std::unique_ptr<Statement>>& stmts, std::size_t index, const symbolic::Node& end);
+			void leave();
+			/**
+			 * @brief Gives the abstract statement ```offset``` positions ahead in the current sequence.
+			 */
+			const Statement* peek(std::size_t offset) const;
+			void skip(std::size_t count);
+			/**
+			 * @brief Gives the node reached before the next abstract statement of the current sequence.
+			 */
+			symbolic::Node current() const;
+	};
+
+
+	/******************************************************************************
+		BOUNDED UNROLLING
+	 ******************************************************************************/
+
+	/**
+	 * @brief Symbolic encoding of all executions of a (concrete) program up to a bound.
+	 * @details Loops are unwound at most ```bound``` times, calls are inlined as long as the
+	 *          called function occurs at most ```bound``` times on the (inlined) call stack.
+	 *          Variables are renamed SSA-style to ```SymbolicConstant```s just like
+	 *          ```TraceableStatement::con``` does for traces. After a branch both sides
+	 *          are merged into fresh constants whose value depends on the branch taken.
+	 *          Executions exceeding the bound are blocked, their guards are kept as cutoffs.
+	 *          Indices are never reused for the same counter map ```top```; hence, the
+	 *          constraints of several unrollings sharing ```top``` can be conjoined.
+	 * @see FunDef::unroll
+	 */
+	class Unrolling {
+		public:
+			typedef std::map<const VarDef*, std::size_t> lvalmap_t;
+			struct State {
+				z3::expr guard;
+				VersionMap lvalmap;
+			};
+
+		private:
+			/**
+			 * @brief A loop iteration or call that exceeded the bound and is unrolled by a later ```extend```.
+			 * @details Executions continue after the hole with fresh constants (```post```) under the
+			 *          guard ```reached```; both are left undefined until the hole is filled.
+			 */
+			struct Hole {
+				const While* loop;
+				const Call* call;
+				std::vector<const FunDef*> stack;
+				State pre;
+				z3::expr reached;
+				VersionMap post;
+			};
+
+			z3::context& _context;
+			std::size_t _bound;
+			lvalmap_t& _top;
+			std::vector<const FunDef*> _stack;
+			State _state;
+			std::vector<z3::expr> _constraints;
+			std::vector<std::pair<const Assert*, z3::expr>> _violations;
+			std::vector<Hole> _holes;
+			std::size_t _num_holes;
+
+			z3::expr value(const VarDef* var, const VersionMap& lvalmap) const;
+			void suspend(const While* loop, const Call* call);
+
+		public:
+			Unrolling(z3::context& context, std::size_t bound, lvalmap_t& top);
+			std::size_t bound() const { return _bound; }
+			const State& state() const { return _state; }
+			void restore(const State& state) { _state = state; }
+			/**
+			 * @brief Merges the given states (of mutually exclusive branches) into the current state.
+			 */
+			void join(const std::vector<State>& states);
+			/**
+			 * @brief Translates an expression over program variables into the current SSA constants.
+			 */
+			z3::expr eval(const Expr& expr);
+			void assume(const z3::expr& cond) { _state.guard = _state.guard && cond; }
+			void assign(const std::vector<const VarDef*>& vars, const TraceableStatement& stmt);
+			void check(const Assert& stmt, const z3::expr& cond);
+			/**
+			 * @brief Leaves the remaining iterations of ```loop``` to a later ```extend```.
+			 */
+			void suspend(const While& loop) { suspend(&loop, NULL); }
+			/**
+			 * @brief Leaves ```call```, which exceeds the recursion bound, to a later ```extend```.
+			 */
+			void suspend(const Call& call) { suspend(NULL, &call); }
+			bool enter(const FunDef* fun);
+			void leave(const State& caller);
+			/**
+			 * @brief Increments the bound by unrolling one more step at every hole left so far,
+			 *        i.e. one more loop iteration or one more level of recursion.
+			 * @details The constraints added so far remain valid, new ones are appended.
+			 */
+			void extend();
+			/**
+			 * @brief Definitions of all SSA constants introduced so far; must hold in every execution.
+			 */
+			const std::vector<z3::expr>& constraints() const { return _constraints; }
+			/**
+			 * @brief Assertions together with the condition under which they are violated.
+			 */
+			const std::vector<std::pair<const Assert*, z3::expr>>& violations() const { return _violations; }
+			/**
+			 * @brief Conditions under which an execution exceeds the bound.
+			 */
+			std::vector<z3::expr> cutoffs() const;
+			/**
+			 * @brief Conditions under which an execution continues after a hole; they must be assumed
+			 *        false since the holes are not unrolled yet.
+			 */
+			std::vector<z3::expr> resumptions() const;
+	};
+
+
 	/******************************************************************************
 		EXCEPTIONS
 	 ******************************************************************************/
 
 	class ValidationError: public std::exception {
 		private:
-			const char* _msg;
-			const char* what() const throw() { return _msg; }
+			std::string _msg;
+			const char* what() const throw() { return _msg.c_str(); }
 
 		public:
-			ValidationError(std::string msg) : _msg(msg.c_str()) {}
+			ValidationError(std::string msg) : _msg(msg) {}
 	};
 
 	class UnsupportedOperationError: public std::exception {
 		private:
-			const char* _msg;
-			const char* what() const throw() { return _msg; }
+			std::string _msg;
+			const char* what() const throw() { return _msg.c_str(); }
 
 		public:
-			UnsupportedOperationError(std::string msg) : _msg(msg.c_str()) {}
+			UnsupportedOperationError(std::string msg) : _msg(msg) {}
 	};
 
 }
@@ -2,6 +2,9 @@
 #include <queue>
 #include "ast/ast.hpp"
 #include "ast/abstraction_utils.hpp"
+#include "ast/query_log.hpp"
+#include "ast/query_limits.hpp"
+#include "ast/term_cache.hpp"
 
 using namespace ast;
 
@@ -9,9 +12,13 @@ using namespace ast;
 Program* Program::abstract(const PredicateList& pl) const {
 	std::vector<VarDef*> vars;
 	std::vector<FunDef*> funs;
+	std::unique_ptr<Arena> arena(new Arena());
+	ArenaScope scope(*arena);
 
 	z3::context context;
 	z3::solver solver(context);
+	QueryLimits::instance().apply(solver);
+	TermCache terms(context);
 
 	for (Predicate* p : pl.preds_for("global")) {
 		vars.push_back(new VarDef(p->varname(), bool_t));
@@ -19,12 +26,14 @@ Program* Program::abstract(const PredicateList& pl) const {
 	}
 
 	for (auto& f : _funs)
-		funs.push_back(f->abstract(pl, solver, context));
+		if (!f->is_excluded())
+			funs.push_back(f->abstract(pl, solver, context));
 
 	// remove every 'z3::expr' from the predicates as they need 'cntxt' upon deletion
 	pl.clear_z3();
 
 	Program* prog = new Program(vars, funs);
+	prog->_arena = std::move(arena);
 	prog->validate();
 	return prog;
 }
@@ -60,22 +69,31 @@ FunDef* FunDef::abstract(const PredicateList& pl, z3::solver& solver, z3::contex
 
 /**** Statements ****/
 
-DocString* mk_doc(std::string ctrl, const Expr& expr) {
+std::string describe(std::string ctrl, const Expr& expr) {
 	std::stringstream com;
 	com << ctrl << "(";
 	expr.prettyprint(com);
 	com << ")" << std::endl;
-	return new DocString(com);
+	return com.str();
 }
 
-DocString* mk_doc(const SimpleAssignment& ass) {
+std::string describe(const Statement& stmt) {
 	std::stringstream com;
-	ass.prettyprint(com, 0);
-	return new DocString(com);
+	stmt.prettyprint(com, 0);
+	return com.str();
+}
+
+DocString* mk_doc(std::string ctrl, const Expr& expr) {
+	return new DocString(describe(ctrl, expr));
+}
+
+DocString* mk_doc(const SimpleAssignment& ass) {
+	return new DocString(describe(ass));
 }
 
 std::vector<Statement*> While::abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const {
 	std::vector<Statement*> stmts;
+	QueryOrigin origin("abstraction", describe("while", *_cond));
 
 	auto posz3cond = _cond->z3(context);
 	auto negz3cond = !posz3cond;
@@ -97,6 +115,7 @@ std::vector<Statement*> While::abstract(const std::vector<Predicate*> preds, z3:
 std::vector<Statement*> Ite::abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const {
 	std::vector<Statement*> if_stmts;
 	std::vector<Statement*> else_stmts;
+	QueryOrigin origin("abstraction", describe("if", *_cond));
 
 	auto posz3cond = _cond->z3(context);
 	auto negz3cond = !posz3cond;
@@ -120,6 +139,8 @@ std::vector<Statement*> Ite::abstract(const std::vector<Predicate*> preds, z3::s
 }
 
 std::vector<Statement*> Call::abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const {
+	// excluded functions have no effect on the caller, cf. Program::exclude_procedures
+	if (_decl->is_excluded()) return {};
 	Call* c = new Call(_funname, *this);
 	c->_decl = _decl;
 	return { c };
@@ -128,6 +149,7 @@ std::vector<Statement*> Call::abstract(const std::vector<Predicate*> preds, z3::
 std::vector<Statement*> SimpleAssignment::abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const {
 	std::vector<VarName*> vars;
 	std::vector<Expr*> exprs;
+	QueryOrigin origin("abstraction", describe(*this));
 
 	// create vectors for _var and _expr repr -> allows using the replace function from z3
 	auto z3var = z3::expr_vector(context);
@@ -137,7 +159,7 @@ std::vector<Statement*> SimpleAssignment::abstract(const std::vector<Predicate*>
 
 	for (Predicate* p : preds) {
 		const Expr* pex = p->expr();
-		if (!pex->contains(_var->name())) continue;
+		if (!pex->contains(_var->symbol())) continue;
 
 		z3::expr z3p = p->z3();
 		z3::expr poswp = z3p.substitute(z3var, z3expr);
@@ -146,13 +168,14 @@ std::vector<Statement*> SimpleAssignment::abstract(const std::vector<Predicate*>
 		Expr* pos = weakest_whatsoever(preds, poswp, solver);
 		Expr* neg = weakest_whatsoever(preds, negwp, solver);
 
-		// TODO: one could add an simplification step here; but: it is done on the BDD level anyway
-		Expr* guard = new BinaryExpression(log_or, pos, neg);
-		Expr* newval = new UnaryExpression(log_not, neg->copy());
+		// simplified here already (instead of on the BDD level only) to keep Expr::cfg cheap
+		// 'neg' is handed over to the guard, so it is copied before
+		std::unique_ptr<Expr> newval(new UnaryExpression(log_not, neg->copy()));
+		std::unique_ptr<Expr> guard(new BinaryExpression(log_or, pos, neg));
 
 		// note: the resulting assignment must be a Conditional, i.e. of the form 'guard ? value : unkown'
 		vars.push_back(new VarName(p->varname()));
-		exprs.push_back(new Conditional(guard, newval, new Unknown()));
+		exprs.push_back(new Conditional(guard->simplify(), newval->simplify(), new Unknown()));
 	}
 	
 	auto doc = mk_doc(*this);
@@ -164,6 +187,7 @@ std::vector<Statement*> SimpleAssignment::abstract(const std::vector<Predicate*>
 std::vector<Statement*> ParallelAssignment::abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const {
 	std::vector<VarName*> vars;
 	std::vector<Expr*> exprs;
+	QueryOrigin origin("abstraction", describe(*this));
 
 	// create vectors for _var and _expr repr -> allows using the replace function from z3
 	auto z3vars = z3::expr_vector(context);
@@ -171,12 +195,12 @@ std::vector<Statement*> ParallelAssignment::abstract(const std::vector<Predicate
 	for (const auto& v : _vars) z3vars.push_back(v->z3(context));
 	for (const auto& e : _exprs) z3exprs.push_back(e->z3(context));
 
+	SymbolSet assigned;
+	for (const auto& v : _vars) assigned |= SymbolTable::instance().singleton(v->symbol());
+
 	for (Predicate* p : preds) {
 		const Expr* pex = p->expr();
-		bool contains_any = false;
-		for (const auto& v : _vars)
-			contains_any = contains_any || pex->contains(v->name());
-		if (!contains_any) continue;
+		if (!pex->contains_any(assigned)) continue;
 
 		z3::expr z3p = p->z3();
 		z3::expr poswp = z3p.substitute(z3vars, z3exprs);
@@ -185,13 +209,14 @@ std::vector<Statement*> ParallelAssignment::abstract(const std::vector<Predicate
 		Expr* pos = weakest_whatsoever(preds, poswp, solver);
 		Expr* neg = weakest_whatsoever(preds, negwp, solver);
 
-		// TODO: one could add an simplification step here; but: it is done on the BDD level anyway
-		Expr* guard = new BinaryExpression(log_or, pos, neg);
-		Expr* newval = new UnaryExpression(log_not, neg->copy());
+		// simplified here already (instead of on the BDD level only) to keep Expr::cfg cheap
+		// 'neg' is handed over to the guard, so it is copied before
+		std::unique_ptr<Expr> newval(new UnaryExpression(log_not, neg->copy()));
+		std::unique_ptr<Expr> guard(new BinaryExpression(log_or, pos, neg));
 
 		// note: the resulting assignment must be a Conditional, i.e. of the form 'guard ? value : unkown'
 		vars.push_back(new VarName(p->varname()));
-		exprs.push_back(new Conditional(guard, newval, new Unknown()));
+		exprs.push_back(new Conditional(guard->simplify(), newval->simplify(), new Unknown()));
 	}
 	
 	auto doc = new DocString("ParallelAssignment\n"); // mk_doc(*this);
@@ -207,6 +232,7 @@ std::vector<Statement*> Assume::abstract(const std::vector<Predicate*> preds, z3
 std::vector<Statement*> Assert::abstract(const std::vector<Predicate*> preds, z3::solver& solver, z3::context& context) const {
 	// assert(cond) <==> if (cond) { } else { assert(false); }
 	// --> handle assert like an if
+	QueryOrigin origin("abstraction", describe("assert", *_expr));
 	auto posz3cond = _expr->z3(context);
 	auto negz3cond = !posz3cond;
 
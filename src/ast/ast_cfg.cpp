@@ -1,5 +1,7 @@
 #include "ast/ast.hpp"
 
+#include <algorithm>
+
 using namespace ast;
 
 
@@ -9,22 +11,8 @@ using namespace ast;
 
 #define ASSERT_FAIL_BLOCK symbolic::Node(symbolic::BLOCK, 0)
 
-class TemporaryNode {
-	// owns an object which can be set, referenced and released (claim ownership)
-	private:
-		std::unique_ptr<symbolic::Node> _node;
-	public:
-		TemporaryNode() {}
-		TemporaryNode(symbolic::Node&& n) { _node.reset(new symbolic::Node(std::move(n))); }
-		TemporaryNode(symbolic::Node& n) { _node.reset(new symbolic::Node(n)); }
-		TemporaryNode& operator=(symbolic::Node&& n) { _node.reset(new symbolic::Node(std::move(n))); return *this; }
-		TemporaryNode& operator=(symbolic::Node& n) { _node.reset(new symbolic::Node(n)); return *this; }
-		symbolic::Node& operator*() { return *_node; }
-		symbolic::Node* operator&() { return _node.release(); }
-};
-
-symbolic::Node* mk_Block(std::size_t id) {
-	return new symbolic::Node(symbolic::BLOCK, id);
+symbolic::Node mk_Block(std::size_t id) {
+	return symbolic::Node(symbolic::BLOCK, id);
 }
 
 bool contains_bdd(const std::vector<BDD>& vars, const BDD b) {
@@ -52,6 +40,11 @@ BDD keep_all_vars(const symbolic::ControlFlowGraph& cfg) {
 
 #define KEEP_ALL keep_all_vars(cfg)
 
+bool is_straight(const Statement& stmt) {
+	// neither branches nor calls, i.e. a single transition of the CFG
+	return dynamic_cast<const Assignment*>(&stmt) != NULL || dynamic_cast<const Assume*>(&stmt) != NULL;
+}
+
 BDD assignment2bdd(const symbolic::ControlFlowGraph& cfg, const VarName& v, const Expr& e) {
 	const Conditional* ec = dynamic_cast<const Conditional*>(&e);
 	assert(ec != NULL);
@@ -70,7 +63,7 @@ BDD assignment2bdd(const symbolic::ControlFlowGraph& cfg, const VarName& v, cons
 	CFG
  ******************************************************************************/
 
-symbolic::ControlFlowGraph* Program::cfg() {
+symbolic::ControlFlowGraph* Program::cfg(bool large_blocks) {
 	std::size_t numVars = 0;
 	std::size_t numGlob , numLoc;
 	// block0 = blockAssertFail
@@ -85,13 +78,17 @@ symbolic::ControlFlowGraph* Program::cfg() {
 		v->cfg_pass_one(numVars);
 	numGlob = numVars;
 
-	// TODO: local variables --> momentan hat jede lokale variable eine eigenen variable im CFG --> muss nicht sein, wir brauchen lediglich genügend im cfg
-	for (auto& f : _funs)
-		f->cfg_pass_one(numVars, numBlocks, numProcs, numCalls);
-	numLoc = numVars - numGlob;
+	// local variables are slots of a frame following the globals; since the locals of a caller are
+	// quantified on calls and restored on returns, all functions share the slots of the largest frame
+	numLoc = 0;
+	for (auto& f : _funs) {
+		std::size_t numFrame = numGlob;
+		f->cfg_pass_one(numFrame, numBlocks, numProcs, numCalls, large_blocks);
+		numLoc = std::max(numLoc, numFrame - numGlob);
+	}
 
 	// create cfg
-	symbolic::ControlFlowGraph* cfg = new symbolic::ControlFlowGraph(numMains, numBlocks, numProcs, numCalls, numGlob, numLoc);
+	symbolic::ControlFlowGraph* cfg = new symbolic::ControlFlowGraph(numMains, numBlocks, numProcs, numCalls, numGlob, numLoc, large_blocks);
 
 	// connect main nodes of cfg to main function of program
 	BDD keep_globals = keep_all_vars_but(*cfg, cfg->localVariables());
@@ -120,117 +117,183 @@ void VarDef::cfg_pass_one(std::size_t& index) {
 	_cfg_id = index++;
 }
 
-void FunDef::cfg_pass_one(std::size_t& numVars, std::size_t& numBlocks, std::size_t& numProcs, std::size_t& numCalls) {
-	_cfg_proc.reset(new symbolic::Procedure(numProcs++));
+symbolic::Node cfg_pass_one(std::vector<std::unique_ptr<Statement>>& stmts, std::vector<std::unique_ptr<LargeBlock>>& blocks, std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node pre, bool large_blocks, const symbolic::Node* post) {
+	// creates the nodes of a sequence of statements; with large blocks, consecutive assignments and
+	// assumptions share a single transition which ends in ```post``` (if given) when closing the sequence
+	blocks.clear();
+	if (!large_blocks) {
+		for (auto& s : stmts)
+			pre = s->cfg_pass_one(numNodes, numCalls, numProcs, pre, false);
+		return pre;
+	}
+
+	std::vector<const TraceableStatement*> straight;
+	symbolic::Node begin;
+	auto close = [&] (symbolic::Node end) {
+		blocks.push_back(std::unique_ptr<LargeBlock>(new LargeBlock(straight, begin, end)));
+		straight.clear();
+		return end;
+	};
+	for (auto& s : stmts) {
+		if (is_straight(*s)) {
+			if (straight.empty()) begin = pre;
+			s->Statement::cfg_pass_one(numNodes, numCalls, numProcs, begin, true);
+			straight.push_back(static_cast<const TraceableStatement*>(s.get()));
+			continue;
+		}
+		if (dynamic_cast<const DocString*>(s.get()) != NULL) {
+			s->cfg_pass_one(numNodes, numCalls, numProcs, pre, true);
+			continue;
+		}
+		// the block leading to a call ends in the call node itself, cf. Call::cfg_pass_two
+		if (!straight.empty()) pre = close(dynamic_cast<const Call*>(s.get()) != NULL ? symbolic::Call(numCalls).call() : mk_Block(numNodes++));
+		pre = s->cfg_pass_one(numNodes, numCalls, numProcs, pre, true);
+	}
+	if (!straight.empty()) pre = close(post != NULL ? *post : mk_Block(numNodes++));
+	return pre;
+}
+
+void FunDef::cfg_pass_one(std::size_t& numVars, std::size_t& numBlocks, std::size_t& numProcs, std::size_t& numCalls, bool large_blocks) {
+	_cfg_proc = symbolic::Procedure(numProcs++);
 
 	for (auto& v : _vars)
 		v->cfg_pass_one(numVars);
 
-	TemporaryNode pre = _cfg_proc->entry();
-	for (auto& s : _stmts)
-		pre = s->cfg_pass_one(numBlocks, numCalls, numProcs, *pre);
-	_cfg_last.reset(&pre);
+	symbolic::Node exit = _cfg_proc.exit();
+	_cfg_last = ::cfg_pass_one(_stmts, _cfg_blocks, numBlocks, numCalls, numProcs, _cfg_proc.entry(), large_blocks, &exit);
 }
 
-symbolic::Node Statement::cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre) {
-	_cfg_pre.reset(new symbolic::Node(pre));
+symbolic::Node Statement::cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre, bool large_blocks) {
+	_cfg_pre = pre;
 	return pre;
 }
 
-symbolic::Node While::cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre) {
+symbolic::Node While::cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre, bool large_blocks) {
 	assert(dynamic_cast<Unknown*>(_cond.get()) != NULL);
-	Statement::cfg_pass_one(numNodes, numCalls, numProcs, pre);
+	Statement::cfg_pass_one(numNodes, numCalls, numProcs, pre, large_blocks);
 
-	TemporaryNode node = pre;
-	for (auto& s : _stmts)
-		node = s->cfg_pass_one(numNodes, numCalls, numProcs, *node);
-	_cfg_body_post.reset(&node);
+	// a trailing block of the body returns to the loop head immediately
+	_cfg_body_post = ::cfg_pass_one(_stmts, _cfg_blocks, numNodes, numCalls, numProcs, pre, large_blocks, &_cfg_pre);
 
-	_cfg_post.reset(mk_Block(numNodes++));
-	return *_cfg_post;
+	_cfg_post = mk_Block(numNodes++);
+	return _cfg_post;
 }
 
-symbolic::Node Ite::cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre) {
+symbolic::Node Ite::cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre, bool large_blocks) {
 	assert(dynamic_cast<Unknown*>(_cond.get()) != NULL);
-	Statement::cfg_pass_one(numNodes, numCalls, numProcs, pre);
+	Statement::cfg_pass_one(numNodes, numCalls, numProcs, pre, large_blocks);
 
-	TemporaryNode node = pre;
-	for (auto& s : _if)
-		node = s->cfg_pass_one(numNodes, numCalls, numProcs, *node);
-	_cfg_if_post.reset(&node);
+	// a trailing block of the if branch ends in _cfg_post, unless the else branch is empty (which
+	// joins pre and _cfg_post, i.e. the transitions would not be told apart by their nodes)
+	bool empty_else = true;
+	for (const auto& s : _else)
+		empty_else &= dynamic_cast<const DocString*>(s.get()) != NULL;
+	symbolic::Node post = large_blocks ? mk_Block(numNodes++) : symbolic::Node();
+	_cfg_if_post = ::cfg_pass_one(_if, _cfg_blocks, numNodes, numCalls, numProcs, pre, large_blocks, empty_else ? NULL : &post);
 
-	node = pre;
-	for (auto& s : _else)
-		node = s->cfg_pass_one(numNodes, numCalls, numProcs, *node);
-	_cfg_else_post.reset(&node);
+	std::vector<std::unique_ptr<LargeBlock>> else_blocks;
+	_cfg_else_post = ::cfg_pass_one(_else, else_blocks, numNodes, numCalls, numProcs, pre, large_blocks, NULL);
+	std::move(else_blocks.begin(), else_blocks.end(), std::back_inserter(_cfg_blocks));
 
-	_cfg_post.reset(mk_Block(numNodes++));
-	return *_cfg_post;
+	_cfg_post = large_blocks ? post : mk_Block(numNodes++);
+	return _cfg_post;
 }
 
-symbolic::Node Call::cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre) {
-	Statement::cfg_pass_one(numNodes, numCalls, numProcs, pre);
-	_cfg_call.reset(new symbolic::Call(numCalls++));
-	return _cfg_call->retrn();
+symbolic::Node Call::cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre, bool large_blocks) {
+	Statement::cfg_pass_one(numNodes, numCalls, numProcs, pre, large_blocks);
+	_cfg_call = symbolic::Call(numCalls++);
+	return _cfg_call.retrn();
 }
 
-symbolic::Node Assignment::cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre) {
-	Statement::cfg_pass_one(numNodes, numCalls, numProcs, pre);
-	_cfg_post.reset(mk_Block(numNodes++));
-	return *_cfg_post;
+symbolic::Node Assignment::cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre, bool large_blocks) {
+	Statement::cfg_pass_one(numNodes, numCalls, numProcs, pre, large_blocks);
+	_cfg_post = mk_Block(numNodes++);
+	return _cfg_post;
 }
 
-symbolic::Node AssBase::cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre) {
-	Statement::cfg_pass_one(numNodes, numCalls, numProcs, pre);
-	_cfg_post.reset(mk_Block(numNodes++));
-	/*output*///std::cout << "AssBase::cfg_pass_one" << "##post=" << _cfg_post->tostr() << std::endl;
-	return *_cfg_post;
+symbolic::Node AssBase::cfg_pass_one(std::size_t& numNodes, std::size_t& numCalls, std::size_t& numProcs, symbolic::Node& pre, bool large_blocks) {
+	Statement::cfg_pass_one(numNodes, numCalls, numProcs, pre, large_blocks);
+	_cfg_post = mk_Block(numNodes++);
+	/*output*///std::cout << "AssBase::cfg_pass_one" << "##post=" << _cfg_post.tostr() << std::endl;
+	return _cfg_post;
 }
 
 /******************************************************************************
 	CFG_PASS_TWO
  ******************************************************************************/
 
+std::set<const Statement*> composed(const std::vector<std::unique_ptr<LargeBlock>>& blocks) {
+	// statements that have no transitions of their own
+	std::set<const Statement*> result;
+	for (const auto& b : blocks)
+		result.insert(b->statements().begin(), b->statements().end());
+	return result;
+}
+
 void FunDef::cfg_pass_two(symbolic::ControlFlowGraph& cfg) const {
+	auto skip = composed(_cfg_blocks);
+	for (const auto& b : _cfg_blocks)
+		b->cfg_pass_two(cfg);
 	for (const auto& s : _stmts)
-		s->cfg_pass_two(cfg);
+		if (!skip.count(s.get())) s->cfg_pass_two(cfg);
 	
-	cfg.addTransition(*_cfg_last, _cfg_proc->exit(), KEEP_ALL);
+	if (_cfg_last != _cfg_proc.exit()) cfg.addTransition(_cfg_last, _cfg_proc.exit(), KEEP_ALL);
 }
 
 void While::cfg_pass_two(symbolic::ControlFlowGraph& cfg) {
 	assert(dynamic_cast<Unknown*>(_cond.get()) != NULL);
-	cfg.addTransition(*_cfg_pre, *_cfg_post, KEEP_ALL);
-	cfg.addTransition(*_cfg_body_post, *_cfg_pre, KEEP_ALL);
-	cfg.addTransition(*_cfg_body_post, *_cfg_post, KEEP_ALL);
+	cfg.addTransition(_cfg_pre, _cfg_post, KEEP_ALL);
+	if (_cfg_body_post != _cfg_pre) {
+		cfg.addTransition(_cfg_body_post, _cfg_pre, KEEP_ALL);
+		cfg.addTransition(_cfg_body_post, _cfg_post, KEEP_ALL);
+	}
 
 	// substatements connect to _cfg_pre
+	auto skip = composed(_cfg_blocks);
+	for (const auto& b : _cfg_blocks)
+		b->cfg_pass_two(cfg);
 	for (const auto& s : _stmts)
-		s->cfg_pass_two(cfg);
+		if (!skip.count(s.get())) s->cfg_pass_two(cfg);
 }
 
 void Ite::cfg_pass_two(symbolic::ControlFlowGraph& cfg) {
 	assert(dynamic_cast<Unknown*>(_cond.get()) != NULL);
 	/*output*///std::cout << "Ite::cfg_pass_two" << std::endl;
 
-	cfg.addTransition(*_cfg_if_post, *_cfg_post, KEEP_ALL);
-	cfg.addTransition(*_cfg_else_post, *_cfg_post, KEEP_ALL);
+	if (_cfg_if_post != _cfg_post) cfg.addTransition(_cfg_if_post, _cfg_post, KEEP_ALL);
+	cfg.addTransition(_cfg_else_post, _cfg_post, KEEP_ALL);
 	
 	// substatements connect to _cfg_pre
+	auto skip = composed(_cfg_blocks);
+	for (const auto& b : _cfg_blocks)
+		b->cfg_pass_two(cfg);
 	for (const auto& s : _if)
-		s->cfg_pass_two(cfg);
+		if (!skip.count(s.get())) s->cfg_pass_two(cfg);
 	for (const auto& s : _else)
-		s->cfg_pass_two(cfg);
+		if (!skip.count(s.get())) s->cfg_pass_two(cfg);
 }
 
 void Call::cfg_pass_two(symbolic::ControlFlowGraph& cfg) {
 	/*output*///std::cout << "Call::cfg_pass_two" << std::endl;
-	cfg.addTransition(*_cfg_pre, _cfg_call->call(), KEEP_ALL); // one more transition for the sake of simplicity
-	cfg.addCall(*_cfg_call, *(_decl->cfg_procedure()));
+	// a preceding large block ends in the call node itself
+	if (_cfg_pre != _cfg_call.call()) cfg.addTransition(_cfg_pre, _cfg_call.call(), KEEP_ALL); // one more transition for the sake of simplicity
+	cfg.addCall(_cfg_call, *(_decl->cfg_procedure()));
 }
 
-void ParallelAssignment::cfg_pass_two(symbolic::ControlFlowGraph& cfg) {
-	/*output*///std::cout << "ParallelAssignment::cfg_pass_two: " << _vars.size() << std::endl;
+void LargeBlock::cfg_pass_two(symbolic::ControlFlowGraph& cfg) {
+	BDD relation = _stmts.front()->cfg_relation(cfg);
+	for (std::size_t i = 1; i < _stmts.size(); i++)
+		relation = cfg.compose(relation, _stmts.at(i)->cfg_relation(cfg));
+	cfg.addTransition(_cfg_pre, _cfg_post, relation);
+}
+
+BDD TraceableStatement::cfg_relation(const symbolic::ControlFlowGraph& cfg) const {
+	assert(false);
+	return cfg.zero();
+}
+
+BDD ParallelAssignment::cfg_relation(const symbolic::ControlFlowGraph& cfg) const {
+	/*output*///std::cout << "ParallelAssignment::cfg_relation: " << _vars.size() << std::endl;
 
 	std::vector<BDD> but;
 	for (const auto& v : _vars) but.push_back(v->cfg(cfg));
@@ -240,31 +303,47 @@ void ParallelAssignment::cfg_pass_two(symbolic::ControlFlowGraph& cfg) {
 	for (std::size_t i = 0; i < _vars.size(); i++)
 		assignment &= assignment2bdd(cfg, *_vars.at(i), *_exprs.at(i));
 
-	cfg.addTransition(*_cfg_pre, *_cfg_post, assignment & keep_remaining);
+	return assignment & keep_remaining;
 }
 
-void SimpleAssignment::cfg_pass_two(symbolic::ControlFlowGraph& cfg) {
-	/*output*///std::cout << "SimpleAssignment::cfg_pass_two" << std::endl;
+void ParallelAssignment::cfg_pass_two(symbolic::ControlFlowGraph& cfg) {
+	cfg.addTransition(_cfg_pre, _cfg_post, cfg_relation(cfg));
+}
+
+BDD SimpleAssignment::cfg_relation(const symbolic::ControlFlowGraph& cfg) const {
 	BDD assignment = assignment2bdd(cfg, *_var, *_expr);
 	BDD keep_remaining = keep_all_vars_but(cfg, { _var->cfg(cfg) });
-	cfg.addTransition(*_cfg_pre, *_cfg_post, assignment & keep_remaining);
+	return assignment & keep_remaining;
+}
+
+void SimpleAssignment::cfg_pass_two(symbolic::ControlFlowGraph& cfg) {
+	/*output*///std::cout << "SimpleAssignment::cfg_pass_two" << std::endl;
+	cfg.addTransition(_cfg_pre, _cfg_post, cfg_relation(cfg));
+}
+
+BDD AssBase::cfg_relation(const symbolic::ControlFlowGraph& cfg) const {
+	BDD cond = _expr->cfg(cfg);
+	return cond & KEEP_ALL;
 }
 
 void AssBase::cfg_pass_two(symbolic::ControlFlowGraph& cfg) {
 	/*output*///std::cout << "AssBase::cfg_pass_two" << std::endl;
-	BDD cond = _expr->cfg(cfg);
-	cfg.addTransition(*_cfg_pre, *_cfg_post, cond & KEEP_ALL);
+	cfg.addTransition(_cfg_pre, _cfg_post, cfg_relation(cfg));
 }
 
 void Assert::cfg_pass_two(symbolic::ControlFlowGraph& cfg) {
 	AssBase::cfg_pass_two(cfg);
 	/*output*///std::cout << "Assert::cfg_pass_two" << std::endl;
 	BDD cond = _expr->cfg(cfg);
-	cfg.addTransition(*_cfg_pre, ASSERT_FAIL_BLOCK, !cond & KEEP_ALL);
+	cfg.addTransition(_cfg_pre, ASSERT_FAIL_BLOCK, !cond & KEEP_ALL);
+}
+
+BDD Skip::cfg_relation(const symbolic::ControlFlowGraph& cfg) const {
+	return KEEP_ALL;
 }
 
 void Skip::cfg_pass_two(symbolic::ControlFlowGraph& cfg) {
-	cfg.addTransition(*_cfg_pre, *_cfg_post, KEEP_ALL);
+	cfg.addTransition(_cfg_pre, _cfg_post, cfg_relation(cfg));
 }
 
 void DocString::cfg_pass_two(symbolic::ControlFlowGraph& cfg) {}
@@ -332,29 +411,38 @@ BDD SymbolicConstant::cfg(const symbolic::ControlFlowGraph& cfg) const {
  ******************************************************************************/
 
 void FunDef::collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const {
+	auto skip = composed(_cfg_blocks);
+	for (const auto& b : _cfg_blocks)
+		b->collect_cfg_transitions(collection);
 	for (const auto& s : _stmts)
-		s->collect_cfg_transitions(collection);
+		if (!skip.count(s.get())) s->collect_cfg_transitions(collection);
 }
 
 void While::collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const {
 	// cfg.addTransition(*pre, *_cfg_body_pre, c & keep_all);
-	// cfg.addTransition(*pre, *_cfg_body_post, !c & keep_all);
-	// cfg.addTransition(*_cfg_body_post, *pre, keep_all);
+	// cfg.addTransition(*pre, _cfg_body_post, !c & keep_all);
+	// cfg.addTransition(_cfg_body_post, *pre, keep_all);
 	// just collect the sub-statements; when a trace is inspected the commands from the body will appear anyway...
+	auto skip = composed(_cfg_blocks);
+	for (const auto& b : _cfg_blocks)
+		b->collect_cfg_transitions(collection);
 	for (const auto& s : _stmts)
-		s->collect_cfg_transitions(collection);
+		if (!skip.count(s.get())) s->collect_cfg_transitions(collection);
 }
 
 void Ite::collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const {
 	// cfg.addTransition(*pre, *_cfg_if_pre, c & keep_all);
 	// cfg.addTransition(*pre, *_cfg_else_pre, !c & keep_all);
-	// cfg.addTransition(*_cfg_if_post, *_cfg_post, keep_all);
-	// cfg.addTransition(*_cfg_else_post, *_cfg_post, keep_all);
+	// cfg.addTransition(_cfg_if_post, _cfg_post, keep_all);
+	// cfg.addTransition(_cfg_else_post, _cfg_post, keep_all);
 	// just collection the sub-statements; when a trace is inspected the commands from the corresponding branch will appear anyway...
+	auto skip = composed(_cfg_blocks);
+	for (const auto& b : _cfg_blocks)
+		b->collect_cfg_transitions(collection);
 	for (const auto& s : _if)
-		s->collect_cfg_transitions(collection);
+		if (!skip.count(s.get())) s->collect_cfg_transitions(collection);
 	for (const auto& s : _else)
-		s->collect_cfg_transitions(collection);
+		if (!skip.count(s.get())) s->collect_cfg_transitions(collection);
 }
 
 void exc(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection, symbolic::Node src, symbolic::Node dst, const TraceableStatement* stmt) {
@@ -364,23 +452,27 @@ void exc(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStat
 }
 
 void Call::collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const {
-	// cfg.addCall(*_cfg_call, *_cfg_proc);
+	// cfg.addCall(_cfg_call, *_cfg_proc);
 	// the call needs to be expanded into an parallel assignment representing the procedure summary edge taken
-	exc(collection, _cfg_call->call(), _cfg_call->retrn(), this);
+	exc(collection, _cfg_call.call(), _cfg_call.retrn(), this);
+}
+
+void LargeBlock::collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const {
+	exc(collection, _cfg_pre, _cfg_post, this);
 }
 
 void Assignment::collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const {
-	exc(collection, *_cfg_pre, *_cfg_post, this);
+	exc(collection, _cfg_pre, _cfg_post, this);
 }
 
 void AssBase::collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const {
-	// cfg.addTransition(*pre, *_cfg_post, cond & keep_all);
-	exc(collection, *_cfg_pre, *_cfg_post, this);
+	// cfg.addTransition(*pre, _cfg_post, cond & keep_all);
+	exc(collection, _cfg_pre, _cfg_post, this);
 }
 
 void Assert::collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const {
 	// cfg.addTransition(*pre, ASSERT_FAIL_BLOCK, !cond & keep_all);
-	exc(collection, *_cfg_pre, ASSERT_FAIL_BLOCK, this);
+	exc(collection, _cfg_pre, ASSERT_FAIL_BLOCK, this);
 }
 
 void DocString::collect_cfg_transitions(std::map<std::pair<symbolic::Node, symbolic::Node>, const TraceableStatement*>& collection) const {}
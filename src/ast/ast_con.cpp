@@ -3,52 +3,40 @@
 using namespace ast;
 
 
-Expr* sub(const std::map<const VarDef*, std::size_t>& lvmap, const Expr& e) {
-	// TODO: this is definetly not performant
-	std::map<std::string, const Expr*> repl;
-	for (const auto& e : lvmap)
-		repl[e.first->name()] = new SymbolicConstant(e.first, e.second);
-	auto result = e.replace(repl);
-	for (const auto& e : repl)
-		delete e.second;
-	return result;
-}
-
-
-Expr* Call::con(std::map<const VarDef*, std::size_t>& lvalmap) const {
+Expr* Call::con(VersionMap& lvalmap) const {
 	// locals löschen bzw. auf komische konstanten setzten?
 	// assert(false);
 	return new Literal(true);
 }
 
-Expr* Return::con(std::map<const VarDef*, std::size_t>& lvalmap) const {
+Expr* Return::con(VersionMap& lvalmap) const {
 	// assert(false);
 	return new Literal(true);
 }
 
-Expr* Assume::con(std::map<const VarDef*, std::size_t>& lvalmap) const {
-	return sub(lvalmap, *_expr);
+Expr* Assume::con(VersionMap& lvalmap) const {
+	return _expr->ssa(lvalmap);
 }
 
-Expr* Assert::con(std::map<const VarDef*, std::size_t>& lvalmap) const {
+Expr* Assert::con(VersionMap& lvalmap) const {
 	// TODO: what to do here?
 	return new Literal(true);
 }
 
-Expr* SimpleAssignment::con(std::map<const VarDef*, std::size_t>& lvalmap) const {
-	auto rhs = sub(lvalmap, *_expr);
+Expr* SimpleAssignment::con(VersionMap& lvalmap) const {
+	auto rhs = _expr->ssa(lvalmap);
 	assert(_var->decl() != NULL);
-	lvalmap[_var->decl()]++;
-	auto lhs = sub(lvalmap, *_var);
+	lvalmap.next(_var->decl());
+	auto lhs = _var->ssa(lvalmap);
 	return new BinaryExpression(cmp_eq, lhs, rhs);
 }
 
-Expr* ParallelAssignment::con(std::map<const VarDef*, std::size_t>& lvalmap) const {
+Expr* ParallelAssignment::con(VersionMap& lvalmap) const {
 	std::vector<Expr*> rhss, lhss;
-	for (const auto& e : _exprs) rhss.push_back(sub(lvalmap, *e));
+	for (const auto& e : _exprs) rhss.push_back(e->ssa(lvalmap));
 	for (const auto& v : _vars) assert(v->decl() != NULL);
-	for (const auto& v : _vars) lvalmap[v->decl()]++;
-	for (const auto& v : _vars) lhss.push_back(sub(lvalmap, *v));
+	for (const auto& v : _vars) lvalmap.next(v->decl());
+	for (const auto& v : _vars) lhss.push_back(v->ssa(lvalmap));
 	Expr* result = new BinaryExpression(cmp_eq, lhss.at(0), rhss.at(0));
 	for	(std::size_t i = 1; i < rhss.size(); i++) {
 	   	auto cmp = new BinaryExpression(cmp_eq, lhss.at(i), rhss.at(i));
@@ -57,6 +45,6 @@ Expr* ParallelAssignment::con(std::map<const VarDef*, std::size_t>& lvalmap) con
 	return result;
 }
 
-Expr* Skip::con(std::map<const VarDef*, std::size_t>& lvalmap) const {
+Expr* Skip::con(VersionMap& lvalmap) const {
 	return new Literal(true);
 }
@@ -10,23 +10,28 @@ Program::Program(std::vector<VarDef*> vars, std::vector<FunDef*> funs) {
 		_vars.push_back(std::unique_ptr<VarDef>(v));
 		_vars.back()->_prog = this;
 		_name2var[v->name()] = v;
+		_symbol2var[v->symbol()] = v;
 	}
 	for (FunDef* f : funs) {
 		_funs.push_back(std::unique_ptr<FunDef>(f));
 		_name2fun[f->name()] = f;
+		_symbol2fun[f->symbol()] = f;
 	}
 }
 
 VarDef::VarDef(std::string name, type_t type) : _type(type) {
 	_name = name;
+	_symbol = SymbolTable::instance().intern(name);
 }
 
 FunDef::FunDef(std::string name, std::vector<VarDef*> vars, std::vector<Statement*> stmts) {
 	_name = name;
+	_symbol = SymbolTable::instance().intern(name);
 	for (VarDef* v : vars) {
 		_vars.push_back(std::unique_ptr<VarDef>(v));
 		_vars.back()->_fun = this;
 		_name2var[v->name()] = v;
+		_symbol2var[v->symbol()] = v;
 	}
 	for (Statement* s : stmts) _stmts.push_back(std::unique_ptr<Statement>(s));
 }
@@ -49,12 +54,17 @@ Ite::Ite(Expr* cond, std::vector<Statement*> ifStmts, std::vector<Statement*> el
 	_has_else_branch = true;
 }
 
-Call::Call(std::string name) : _funname(name) {}
+Call::Call(std::string name) : _funname(name), _funsymbol(SymbolTable::instance().intern(name)) {}
 
-Call::Call(std::string name, const Call& trace_father) : _funname(name) {
+Call::Call(std::string name, const Call& trace_father) : _funname(name), _funsymbol(SymbolTable::instance().intern(name)) {
 	_trace_return.reset(new Return());
 }
 
+LargeBlock::LargeBlock(std::vector<const TraceableStatement*> stmts, symbolic::Node pre, symbolic::Node post) : _stmts(stmts), _cfg_post(post) {
+	assert(!_stmts.empty());
+	_cfg_pre = pre;
+}
+
 Assignment::Assignment() {}
 
 Assignment::Assignment(const Assignment* trace_father) : _trace_stmt(trace_father) {}
@@ -106,44 +116,100 @@ DocString::DocString(std::stringstream& docstring) : _doc(docstring.str()) {}
 
 /**** Expressions ****/
 
+std::size_t combine(std::size_t seed, std::size_t value) {
+	return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
 Expr::Expr(type_t type, int precedence) : _type(type) {
 	_precedence = precedence;
 }
 
-Conditional::Conditional(Expr* cond, Expr* yes, Expr* no) : Expr(bool_t, 0) {
-	_cond.reset(cond);
-	_if.reset(yes);
-	_else.reset(no);
+// children handed over as raw pointers are interned, so they must not be used by the caller afterwards
+Conditional::Conditional(Expr* cond, Expr* yes, Expr* no) : Conditional(intern(cond), intern(yes), intern(no)) {}
+
+Conditional::Conditional(std::shared_ptr<Expr> cond, std::shared_ptr<Expr> yes, std::shared_ptr<Expr> no) : Expr(bool_t, 0) {
+	_cond = cond;
+	_if = yes;
+	_else = no;
+	rehash();
+	summarize({ _cond.get(), _if.get(), _else.get() });
 }
 
-UnaryExpression::UnaryExpression(const unary_op& op, Expr* child) : Expr(op.type(), op.precedence()), _op(op) {
-	_child.reset(child);
+// the hashes of composite nodes depend on the hashes of their children, which change when they are validated
+void Conditional::rehash() {
+	_hash = combine(combine(combine(1, _cond->hash()), _if->hash()), _else->hash());
 }
 
-BinaryExpression::BinaryExpression(const binary_op& op, Expr* left, Expr* right) : Expr(op.type(), op.precedence()), _op(op) {
-	_left.reset(left);
-	_right.reset(right);
+UnaryExpression::UnaryExpression(const unary_op& op, Expr* child) : UnaryExpression(op, intern(child)) {}
+
+UnaryExpression::UnaryExpression(const unary_op& op, std::shared_ptr<Expr> child) : Expr(op.type(), op.precedence()), _op(op) {
+	_child = child;
+	rehash();
+	summarize({ _child.get() });
+}
+
+void UnaryExpression::rehash() {
+	_hash = combine(combine(2, std::hash<std::string>()(_op.symbol())), _child->hash());
+}
+
+BinaryExpression::BinaryExpression(const binary_op& op, Expr* left, Expr* right) : BinaryExpression(op, intern(left), intern(right)) {}
+
+BinaryExpression::BinaryExpression(const binary_op& op, std::shared_ptr<Expr> left, std::shared_ptr<Expr> right) : Expr(op.type(), op.precedence()), _op(op) {
+	_left = left;
+	_right = right;
+	rehash();
+	summarize({ _left.get(), _right.get() });
+}
+
+void BinaryExpression::rehash() {
+	_hash = combine(combine(combine(3, std::hash<std::string>()(_op.symbol())), _left->hash()), _right->hash());
 }
 
 Literal::Literal(type_t type, std::string value) : Expr(type, 10) {
 	_value = value;
+	_hash = combine(combine(4, std::hash<std::string>()(_type.name())), std::hash<std::string>()(_value));
 }
 
-Literal::Literal(bool val) : Expr(bool_t, 10), _value(val ? "true" : "false") {}
-Literal::Literal(int val) : Expr(int_t, 10), _value(std::to_string(val)) {}
+Literal::Literal(bool val) : Literal(bool_t, val ? "true" : "false") {}
+Literal::Literal(int val) : Literal(int_t, std::to_string(val)) {}
 
-VarName::VarName(std::string varname) : Literal(unknown_t, varname), _ignore_replace(0) {}
+// variables are identified by their interned name and their declaration (once validated), the inherited '_value' stays empty
+void VarName::rehash() {
+	_hash = combine(combine(combine(5, _symbol), std::hash<const VarDef*>()(_decl)), _ignore_replace);
+}
 
-VarName::VarName(const VarName& cp) : Literal(cp._type, cp._value), _decl(cp._decl), _ignore_replace(cp._ignore_replace) {}
+VarName::VarName(std::string varname) : Literal(unknown_t, ""), _symbol(SymbolTable::instance().intern(varname)), _decl(NULL), _ignore_replace(0) {
+	rehash();
+	summarize();
+}
 
-VarName::VarName(const VarName* cp) : Literal(cp->_type, cp->_value), _decl(cp->_decl), _ignore_replace(cp->_ignore_replace) {}
+VarName::VarName(const VarName& cp) : Literal(cp._type, ""), _symbol(cp._symbol), _decl(cp._decl), _ignore_replace(cp._ignore_replace) {
+	rehash();
+	summarize();
+}
 
-VarName::VarName(const VarDef* def) : Literal(def->type(), def->name()), _ignore_replace(0), _decl(def) {}
+VarName::VarName(const VarName* cp) : Literal(cp->_type, ""), _symbol(cp->_symbol), _decl(cp->_decl), _ignore_replace(cp->_ignore_replace) {
+	rehash();
+	summarize();
+}
 
-Unknown::Unknown() : Literal(bool_t, "unknown") {}
+VarName::VarName(const VarName* cp, std::size_t ignore_replace) : Literal(cp->_type, ""), _symbol(cp->_symbol), _decl(cp->_decl), _ignore_replace(ignore_replace) {
+	rehash();
+	summarize();
+}
+
+VarName::VarName(const VarDef* def) : Literal(def->type(), ""), _symbol(def->symbol()), _decl(def), _ignore_replace(0) {
+	rehash();
+	summarize();
+}
+
+Unknown::Unknown() : Literal(bool_t, "unknown") {
+	_hash = 6;
+}
 
 SymbolicConstant::SymbolicConstant(const VarDef* var, std::size_t num) : _num(num), Literal("<>") {
 	_decl = var;
+	_hash = combine(combine(7, std::hash<const VarDef*>()(_decl)), _num);
 }
 
 // Expression::Expression(Expr* expr) {
@@ -3,16 +3,17 @@
 using namespace ast;
 
 
+// subexpressions are immutable and shared, only the root is copied
 Conditional* Conditional::copy() const {
-	return new Conditional(_cond->copy(), _if->copy(), _else->copy());
+	return new Conditional(_cond, _if, _else);
 }
 
 UnaryExpression* UnaryExpression::copy() const {
-	return new UnaryExpression(_op, _child->copy());
+	return new UnaryExpression(_op, _child);
 }
 
 BinaryExpression* BinaryExpression::copy() const {
-	return new BinaryExpression(_op, _left->copy(), _right->copy());
+	return new BinaryExpression(_op, _left, _right);
 }
 
 Literal* Literal::copy() const {
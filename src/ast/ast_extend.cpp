@@ -1,6 +1,7 @@
 #include "ast/ast.hpp"
 
 #include "ast/abstraction_utils.hpp"
+#include "ast/query_log.hpp"
 
 using namespace ast;
 
@@ -9,6 +10,9 @@ bool PredicateList::contains(const Predicate& pred, std::string scope) const {
 	z3::context ctx;
 	z3::solver solver(ctx);
 	z3::expr p3 = pred.expr()->z3(ctx);
+	std::stringstream desc;
+	pred.expr()->prettyprint(desc);
+	QueryOrigin origin("refinement", "predicate " + desc.str());
 
 	if (is_taut(solver, p3)) return true;
 	if (is_taut(solver, !p3)) return true;
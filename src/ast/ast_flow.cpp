@@ -0,0 +1,106 @@
+#include "ast/ast.hpp"
+
+using namespace ast;
+
+
+/******************************************************************************
+	FLOW GRAPH
+ ******************************************************************************/
+
+void FlowGraph::add_edge(std::size_t src, std::size_t dst, const TraceableStatement* stmt) {
+	assert(src < _size && dst < _size);
+	assert(stmt != NULL);
+	_edges.push_back({ src, dst, stmt });
+}
+
+const TraceableStatement* FlowGraph::own(TraceableStatement* stmt) {
+	_ownership.push_back(std::unique_ptr<TraceableStatement>(stmt));
+	return stmt;
+}
+
+std::vector<const FlowGraph::Edge*> FlowGraph::outgoing(std::size_t loc) const {
+	std::vector<const Edge*> result;
+	for (const auto& e : _edges)
+		if (e.src == loc) result.push_back(&e);
+	return result;
+}
+
+
+/******************************************************************************
+	FLOW
+ ******************************************************************************/
+
+FlowGraph* FunDef::flow() const {
+	FlowGraph* graph = new FlowGraph();
+
+	std::size_t node = graph->entry();
+	for (const auto& s : _stmts)
+		node = s->flow(*graph, node);
+	graph->add_edge(node, graph->exit(), graph->own(new Skip()));
+
+	return graph;
+}
+
+std::size_t While::flow(FlowGraph& graph, std::size_t pre) const {
+	std::size_t body = graph.add_location();
+	std::size_t post = graph.add_location();
+	graph.add_edge(pre, body, graph.own(new Assume(_cond->copy())));
+	graph.add_edge(pre, post, graph.own(new Assume(new UnaryExpression(log_not, _cond->copy()))));
+
+	for (const auto& s : _stmts)
+		body = s->flow(graph, body);
+	graph.add_edge(body, pre, graph.own(new Skip()));
+
+	return post;
+}
+
+std::size_t Ite::flow(FlowGraph& graph, std::size_t pre) const {
+	std::size_t node = graph.add_location();
+	graph.add_edge(pre, node, graph.own(new Assume(_cond->copy())));
+	for (const auto& s : _if)
+		node = s->flow(graph, node);
+	std::size_t if_post = node;
+
+	node = graph.add_location();
+	graph.add_edge(pre, node, graph.own(new Assume(new UnaryExpression(log_not, _cond->copy()))));
+	for (const auto& s : _else)
+		node = s->flow(graph, node);
+	std::size_t else_post = node;
+
+	// join both branches
+	std::size_t post = graph.add_location();
+	graph.add_edge(if_post, post, graph.own(new Skip()));
+	graph.add_edge(else_post, post, graph.own(new Skip()));
+	return post;
+}
+
+std::size_t Call::flow(FlowGraph& graph, std::size_t pre) const {
+	// the call is not expanded; the edge stands for the whole execution of _decl
+	std::size_t post = graph.add_location();
+	graph.add_edge(pre, post, this);
+	return post;
+}
+
+std::size_t Assignment::flow(FlowGraph& graph, std::size_t pre) const {
+	std::size_t post = graph.add_location();
+	graph.add_edge(pre, post, this);
+	return post;
+}
+
+std::size_t AssBase::flow(FlowGraph& graph, std::size_t pre) const {
+	std::size_t post = graph.add_location();
+	graph.add_edge(pre, post, this);
+	return post;
+}
+
+std::size_t Assert::flow(FlowGraph& graph, std::size_t pre) const {
+	// assert(cond) <==> if (cond) { } else { error; }
+	std::size_t post = graph.add_location();
+	graph.add_edge(pre, post, graph.own(new Assume(_expr->copy())));
+	graph.add_edge(pre, graph.error(), graph.own(new Assume(new UnaryExpression(log_not, _expr->copy()))));
+	return post;
+}
+
+std::size_t DocString::flow(FlowGraph& graph, std::size_t pre) const {
+	return pre;
+}
@@ -21,10 +21,7 @@ Expr* Literal::push_ignore() const {
 }
 
 Expr* VarName::push_ignore() const {
-	VarName* result = copy();
-	if (_decl->is_local())
-		result->_ignore_replace++;
-	return result;
+	return new VarName(this, _decl->is_local() ? _ignore_replace + 1 : _ignore_replace);
 }
 
 Expr* Unknown::push_ignore() const {
@@ -55,12 +52,8 @@ Expr* Literal::pop_ignore() const {
 }
 
 Expr* VarName::pop_ignore() const {
-	VarName* result = new VarName(this);
-	if (_decl->is_local()) {
-		assert(_ignore_replace > 0);
-		result->_ignore_replace--;
-	}
-	return result;
+	assert(!_decl->is_local() || _ignore_replace > 0);
+	return new VarName(this, _decl->is_local() ? _ignore_replace - 1 : _ignore_replace);
 }
 
 Expr* Unknown::pop_ignore() const {
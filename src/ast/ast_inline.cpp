@@ -0,0 +1,203 @@
+#include "ast/ast.hpp"
+
+using namespace ast;
+
+
+bool on_cycle(const std::map<const FunDef*, std::set<const FunDef*>>& calls, const FunDef* fun) {
+	std::set<const FunDef*> visited;
+	std::vector<const FunDef*> work_list = { fun };
+	while (!work_list.empty()) {
+		const FunDef* f = work_list.back();
+		work_list.pop_back();
+		auto it = calls.find(f);
+		if (it == calls.end()) continue;
+		for (const FunDef* callee : it->second) {
+			if (callee == fun) return true;
+			if (visited.insert(callee).second) work_list.push_back(callee);
+		}
+	}
+	return false;
+}
+
+std::vector<Statement*> instantiate(const std::vector<std::unique_ptr<Statement>>& stmts, Inlining& inlining) {
+	std::vector<Statement*> result;
+	for (const auto& s : stmts) {
+		auto copy = s->instantiate(inlining);
+		result.insert(result.end(), copy.begin(), copy.end());
+	}
+	return result;
+}
+
+
+/******************************************************************************
+	INLINING
+ ******************************************************************************/
+
+Inlining::Inlining(const Program& prog, std::size_t threshold) : _prog(prog) {
+	std::map<const FunDef*, std::size_t> sizes;
+	for (const auto& e : prog.name2fun()) {
+		std::unique_ptr<FlowGraph> graph(e.second->flow());
+		sizes[e.second] = graph->edges().size();
+		auto& callees = _calls[e.second];
+		for (const auto& edge : graph->edges()) {
+			auto call = dynamic_cast<const Call*>(edge.stmt);
+			if (call != NULL) callees.insert(call->decl());
+		}
+	}
+
+	for (const auto& e : sizes)
+		if (e.first->name() != "main" && e.second <= threshold && !on_cycle(_calls, e.first))
+			_inlinable.insert(e.first);
+}
+
+bool Inlining::expands(const FunDef* fun) const {
+	for (const FunDef* callee : _calls.at(fun))
+		if (inlinable(callee)) return true;
+	return false;
+}
+
+std::string Inlining::fresh(const FunDef& callee, const VarDef& local) const {
+	// the name must neither hide a global nor clash with a local of the caller
+	auto taken = [&] (const std::string& name) {
+		if (_prog.name2var().count(name) || _caller->name2var().count(name)) return true;
+		for (const VarDef* v : _locals)
+			if (v->name() == name) return true;
+		return false;
+	};
+	for (std::size_t n = _count; true; n++) {
+		std::string name = callee.name() + "_" + std::to_string(n) + "_" + local.name();
+		if (!taken(name)) return name;
+	}
+}
+
+void Inlining::enter(const FunDef& caller) {
+	assert(_stack.empty());
+	_caller = &caller;
+	_stack.push_back(Frame());
+}
+
+std::vector<VarDef*> Inlining::leave() {
+	assert(_stack.size() == 1);
+	_stack.clear();
+	_caller = NULL;
+	std::vector<VarDef*> result;
+	std::swap(result, _locals);
+	return result;
+}
+
+std::vector<Statement*> Inlining::expand(const FunDef& callee) {
+	assert(inlinable(&callee) && _caller != NULL);
+	Frame frame;
+	for (const auto& e : callee.name2var()) {
+		const VarDef* local = e.second;
+		if (_prog.var(local->symbol()) != NULL) continue;
+		VarDef* var = new VarDef(fresh(callee, *local), local->type());
+		_locals.push_back(var);
+		frame.names.push_back(std::unique_ptr<VarName>(new VarName(var->name())));
+		frame.renaming[local->symbol()] = frame.names.back().get();
+	}
+
+	_stack.push_back(std::move(frame));
+	std::vector<Statement*> result = callee.instantiate(*this);
+	_stack.pop_back();
+	_count++;
+
+	if (result.empty()) result.push_back(new Skip());
+	return result;
+}
+
+Expr* Inlining::rename(const Expr& expr) const {
+	const Frame& frame = _stack.back();
+	return expr.replace(frame.renaming, frame.renamed);
+}
+
+VarName* Inlining::rename(const VarName& var) const {
+	const auto& renaming = _stack.back().renaming;
+	auto it = renaming.find(var.symbol());
+	return it != renaming.end() ? static_cast<VarName*>(it->second->copy()) : var.copy();
+}
+
+
+/******************************************************************************
+	INLINE CALLS
+ ******************************************************************************/
+
+std::size_t Program::inline_calls(std::size_t threshold) {
+	Inlining inlining(*this, threshold);
+	for (auto& f : _funs)
+		if (inlining.expands(f.get()))
+			f->inline_calls(inlining);
+	validate();
+	return inlining.count();
+}
+
+void FunDef::inline_calls(Inlining& inlining) {
+	inlining.enter(*this);
+	std::vector<Statement*> stmts = ::instantiate(_stmts, inlining);
+	std::vector<VarDef*> locals = inlining.leave();
+
+	_stmts.clear();
+	for (Statement* s : stmts) _stmts.push_back(std::unique_ptr<Statement>(s));
+	for (VarDef* v : locals) {
+		_vars.push_back(std::unique_ptr<VarDef>(v));
+		_vars.back()->_fun = this;
+		_name2var[v->name()] = v;
+		_symbol2var[v->symbol()] = v;
+	}
+}
+
+std::vector<Statement*> FunDef::instantiate(Inlining& inlining) const {
+	return ::instantiate(_stmts, inlining);
+}
+
+
+/******************************************************************************
+	INSTANTIATE
+ ******************************************************************************/
+
+std::vector<Statement*> While::instantiate(Inlining& inlining) const {
+	inlining.enter_loop();
+	std::vector<Statement*> body = ::instantiate(_stmts, inlining);
+	inlining.leave_loop();
+	return { new While(inlining.rename(*_cond), body) };
+}
+
+std::vector<Statement*> Ite::instantiate(Inlining& inlining) const {
+	Expr* cond = inlining.rename(*_cond);
+	if (!_has_else_branch) return { new Ite(cond, ::instantiate(_if, inlining)) };
+	return { new Ite(cond, ::instantiate(_if, inlining), ::instantiate(_else, inlining)) };
+}
+
+std::vector<Statement*> Call::instantiate(Inlining& inlining) const {
+	// the locals of a copy inside a loop would keep their values across iterations
+	if (inlining.inlinable(_decl) && !inlining.in_loop()) return inlining.expand(*_decl);
+	return { new Call(_funname) };
+}
+
+std::vector<Statement*> ParallelAssignment::instantiate(Inlining& inlining) const {
+	std::vector<VarName*> vars;
+	std::vector<Expr*> exprs;
+	for (const auto& v : _vars) vars.push_back(inlining.rename(*v));
+	for (const auto& e : _exprs) exprs.push_back(inlining.rename(*e));
+	return { new ParallelAssignment(vars, exprs) };
+}
+
+std::vector<Statement*> SimpleAssignment::instantiate(Inlining& inlining) const {
+	return { new SimpleAssignment(inlining.rename(*_var), inlining.rename(*_expr)) };
+}
+
+std::vector<Statement*> Assume::instantiate(Inlining& inlining) const {
+	return { new Assume(inlining.rename(*_expr)) };
+}
+
+std::vector<Statement*> Assert::instantiate(Inlining& inlining) const {
+	return { new Assert(inlining.rename(*_expr)) };
+}
+
+std::vector<Statement*> Skip::instantiate(Inlining& inlining) const {
+	return { new Skip() };
+}
+
+std::vector<Statement*> DocString::instantiate(Inlining& inlining) const {
+	return { new DocString(_doc) };
+}
@@ -0,0 +1,135 @@
+#include "ast/ast.hpp"
+
+using namespace ast;
+
+
+#define ASSERT_FAIL_BLOCK symbolic::Node(symbolic::BLOCK, 0)
+
+
+/******************************************************************************
+	LOCATOR
+ ******************************************************************************/
+
+std::size_t Locator::add_location(const symbolic::Node& node) {
+	_nodes.emplace(_size, node);
+	return _size++;
+}
+
+void Locator::enter(const std::vector<std::unique_ptr<Statement>>& stmts, std::size_t index, const symbolic::Node& end) {
+	_stack.push_back({ &stmts, index, &end });
+}
+
+void Locator::leave() {
+	assert(_stack.size() > 0);
+	assert(_stack.back().index == _stack.back().stmts->size());
+	_stack.pop_back();
+}
+
+const Statement* Locator::peek(std::size_t offset) const {
+	assert(_stack.size() > 0);
+	return _stack.back().stmts->at(_stack.back().index + offset).get();
+}
+
+void Locator::skip(std::size_t count) {
+	assert(_stack.size() > 0);
+	_stack.back().index += count;
+	assert(_stack.back().index <= _stack.back().stmts->size());
+}
+
+symbolic::Node Locator::current() const {
+	assert(_stack.size() > 0);
+	const Frame& frame = _stack.back();
+	if (frame.index < frame.stmts->size()) return frame.stmts->at(frame.index)->cfg_pre();
+	else return *frame.end;
+}
+
+
+/******************************************************************************
+	LOCATE
+ ******************************************************************************/
+
+// every statement consumes the statements its abstraction yields (cf. ast_abstraction.cpp)
+// and adds locations just like its flow (cf. ast_flow.cpp)
+
+Locator* FunDef::locate(const FunDef& abstract) const {
+	Locator* locator = new Locator();
+	std::size_t node = locator->add_location(abstract._cfg_proc.entry());
+	locator->add_location(abstract._cfg_proc.exit());
+	locator->add_location(ASSERT_FAIL_BLOCK);
+
+	locator->enter(abstract._stmts, 0, abstract._cfg_last);
+	for (const auto& s : _stmts)
+		node = s->locate(*locator, node);
+	locator->leave();
+
+	return locator;
+}
+
+std::size_t While::locate(Locator& locator, std::size_t pre) const {
+	// abstraction: { doc, while (*) { assume(cond); body }, assume(!cond) }
+	const While* whl = dynamic_cast<const While*>(locator.peek(1));
+	assert(whl != NULL);
+	locator.skip(3);
+	symbolic::Node post_node = locator.current();
+
+	locator.enter(whl->_stmts, 1, whl->_cfg_body_post);
+	std::size_t body = locator.add_location();
+	std::size_t post = locator.add_location(post_node);
+	for (const auto& s : _stmts)
+		body = s->locate(locator, body);
+	locator.leave();
+
+	return post;
+}
+
+std::size_t Ite::locate(Locator& locator, std::size_t pre) const {
+	// abstraction: { doc, if (*) { assume(cond); if } else { assume(!cond); else } }
+	const Ite* ite = dynamic_cast<const Ite*>(locator.peek(1));
+	assert(ite != NULL);
+	locator.skip(2);
+
+	locator.enter(ite->_if, 1, ite->_cfg_if_post);
+	std::size_t node = locator.add_location();
+	for (const auto& s : _if)
+		node = s->locate(locator, node);
+	locator.leave();
+
+	locator.enter(ite->_else, 1, ite->_cfg_else_post);
+	node = locator.add_location();
+	for (const auto& s : _else)
+		node = s->locate(locator, node);
+	locator.leave();
+
+	return locator.add_location();
+}
+
+std::size_t Call::locate(Locator& locator, std::size_t pre) const {
+	// abstraction: { call }
+	locator.skip(1);
+	return locator.add_location();
+}
+
+std::size_t Assignment::locate(Locator& locator, std::size_t pre) const {
+	// abstraction: { doc, assignment }
+	locator.skip(2);
+	return locator.add_location();
+}
+
+std::size_t Skip::locate(Locator& locator, std::size_t pre) const {
+	// abstraction: { }
+	return locator.add_location();
+}
+
+std::size_t AssBase::locate(Locator& locator, std::size_t pre) const {
+	throw UnsupportedOperationError("Abstraction of assume statements is not supported.");
+}
+
+std::size_t Assert::locate(Locator& locator, std::size_t pre) const {
+	// abstraction: { doc, if (*) { assume(cond); } else { assume(!cond); assert(false); } }
+	locator.skip(2);
+	return locator.add_location();
+}
+
+std::size_t DocString::locate(Locator& locator, std::size_t pre) const {
+	return pre;
+}
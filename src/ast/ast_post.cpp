@@ -28,19 +28,22 @@ Expr* Literal::postprocess_interpolant(const Program& prog) const {
 }
 
 Expr* VarName::postprocess_interpolant(const Program& prog) const {
-	assert(std::count(_value.begin(), _value.end(), '%') == 1);
-	assert(std::count(_value.begin(), _value.end(), '$') <= 1);
+	const std::string& value = name();
+	assert(std::count(value.begin(), value.end(), '%') == 1);
+	assert(std::count(value.begin(), value.end(), '$') <= 1);
 	
 	std::vector<std::string> split;
-	boost::split(split, _value, boost::is_any_of("%$"));
+	boost::split(split, value, boost::is_any_of("%$"));
 	assert(split.size() >= 2);
 
+	SymbolTable& symbols = SymbolTable::instance();
 	std::string scope = split[0];
-	std::string name = split[1];
+	symbol_t var = symbols.intern(split[1]);
 
 	const VarDef* decl;
-	if (scope == "global") decl = prog.name2var().at(name);
-	else decl = prog.name2fun().at(scope)->name2var().at(name);
+	if (scope == "global") decl = prog.var(var);
+	else decl = prog.fun(symbols.intern(scope))->var(var);
+	assert(decl != NULL);
 	
 	return new VarName(decl);
 }
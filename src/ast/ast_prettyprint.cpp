@@ -130,7 +130,7 @@ void Literal::prettyprint(std::ostream& os) const {
 
 void VarName::prettyprint(std::ostream& os) const {
 	// this allows debugging the value of _ignore_replace
-	os << _value;
+	os << name();
 	os << "^" << _ignore_replace;
 }
 
@@ -3,32 +3,62 @@
 using namespace ast;
 
 
-Expr* Conditional::replace(const std::map<std::string, const Expr*>& repl) const {
-	return new Conditional(_cond->copy(), _if->replace(repl), _else->replace(repl));
+Expr* Expr::replace(const Substitution& repl) const {
+	ReplaceCache cache;
+	return replace(repl, cache);
 }
 
-Expr* UnaryExpression::replace(const std::map<std::string, const Expr*>& repl) const {
-	return new UnaryExpression(_op, _child->replace(repl));
+Expr* Expr::replace(const Substitution& repl, ReplaceCache& cache) const {
+	Expr* result = rebuild(repl, cache);
+	return result != NULL ? result : copy();
 }
 
-Expr* BinaryExpression::replace(const std::map<std::string, const Expr*>& repl) const {
-	return new BinaryExpression(_op, _left->replace(repl), _right->replace(repl));
+std::shared_ptr<Expr> Expr::replace(const std::shared_ptr<Expr>& expr, const Substitution& repl, ReplaceCache& cache) {
+	// shared subexpressions are rebuilt only once; unchanged ones are kept
+	auto it = cache.find(expr.get());
+	if (it != cache.end()) return it->second.second;
+	Expr* rebuilt = expr->rebuild(repl, cache);
+	auto result = rebuilt != NULL ? intern(rebuilt) : expr;
+	cache.emplace(expr.get(), std::make_pair(expr, result));
+	return result;
 }
 
-Expr* Literal::replace(const std::map<std::string, const Expr*>& repl) const {
-	return copy();
+
+Expr* Conditional::rebuild(const Substitution& repl, ReplaceCache& cache) const {
+	auto yes = replace(_if, repl, cache);
+	auto no = replace(_else, repl, cache);
+	if (yes == _if && no == _else) return NULL;
+	return new Conditional(_cond, yes, no);
+}
+
+Expr* UnaryExpression::rebuild(const Substitution& repl, ReplaceCache& cache) const {
+	auto child = replace(_child, repl, cache);
+	if (child == _child) return NULL;
+	return new UnaryExpression(_op, child);
+}
+
+Expr* BinaryExpression::rebuild(const Substitution& repl, ReplaceCache& cache) const {
+	auto left = replace(_left, repl, cache);
+	auto right = replace(_right, repl, cache);
+	if (left == _left && right == _right) return NULL;
+	return new BinaryExpression(_op, left, right);
+}
+
+Expr* Literal::rebuild(const Substitution& repl, ReplaceCache& cache) const {
+	return NULL;
 }
 
-Expr* VarName::replace(const std::map<std::string, const Expr*>& repl) const {
-	if (_ignore_replace == 0 && repl.count(name()) > 0) return repl.at(name())->copy();
-	else return copy();
+Expr* VarName::rebuild(const Substitution& repl, ReplaceCache& cache) const {
+	if (_ignore_replace > 0) return NULL;
+	auto it = repl.find(_symbol);
+	return it != repl.end() ? it->second->copy() : NULL;
 }
 
-Expr* Unknown::replace(const std::map<std::string, const Expr*>& repl) const {
-	return copy();
+Expr* Unknown::rebuild(const Substitution& repl, ReplaceCache& cache) const {
+	return NULL;
 }
 
-Expr* SymbolicConstant::replace(const std::map<std::string, const Expr*>& repl) const {
+Expr* SymbolicConstant::rebuild(const Substitution& repl, ReplaceCache& cache) const {
 	assert(false);
-	return copy();
+	return NULL;
 }
@@ -0,0 +1,104 @@
+#include "ast/ast.hpp"
+
+#include <typeinfo>
+
+using namespace ast;
+
+
+/******************************************************************************
+	Hash-Consing
+ ******************************************************************************/
+
+// nodes are identified by their structure; as children are interned, comparing them takes constant time
+struct StructuralHash {
+	std::size_t operator()(const Expr* expr) const { return expr->hash(); }
+};
+
+struct StructuralEquality {
+	bool operator()(const Expr* lhs, const Expr* rhs) const { return lhs->equals(*rhs); }
+};
+
+typedef std::unordered_map<const Expr*, std::weak_ptr<Expr>, StructuralHash, StructuralEquality> InternedExprs;
+
+InternedExprs& interned_exprs() {
+	// never destroyed, interned nodes may outlive static objects
+	static InternedExprs* table = new InternedExprs();
+	return *table;
+}
+
+void release_interned(Expr* expr) {
+	// the entry may already belong to an equal node interned while this one was released
+	auto it = interned_exprs().find(expr);
+	if (it != interned_exprs().end() && it->first == expr)
+		interned_exprs().erase(it);
+	delete expr;
+}
+
+std::shared_ptr<Expr> Expr::intern(Expr* expr) {
+	assert(expr != NULL);
+	auto it = interned_exprs().find(expr);
+	if (it != interned_exprs().end()) {
+		auto result = it->second.lock();
+		if (result) {
+			delete expr;
+			return result;
+		}
+		interned_exprs().erase(it);
+	}
+	std::shared_ptr<Expr> result(expr, release_interned);
+	interned_exprs().emplace(expr, result);
+	return result;
+}
+
+void Expr::validate_child(std::shared_ptr<Expr>& child, const Program& prog, const FunDef& fun) {
+	// interned nodes are immutable and possibly shared with other expressions
+	std::unique_ptr<Expr> copy(child->copy());
+	copy->validate(prog, fun);
+	child = intern(copy.release());
+}
+
+
+/******************************************************************************
+	Equality
+ ******************************************************************************/
+
+bool Expr::equals(const Expr& other) const {
+	if (this == &other) return true;
+	if (_hash != other._hash) return false;
+	if (typeid(*this) != typeid(other)) return false;
+	return equals_node(other);
+}
+
+bool Conditional::equals_node(const Expr& other) const {
+	const Conditional& cmp = static_cast<const Conditional&>(other);
+	return _cond == cmp._cond && _if == cmp._if && _else == cmp._else;
+}
+
+bool UnaryExpression::equals_node(const Expr& other) const {
+	const UnaryExpression& cmp = static_cast<const UnaryExpression&>(other);
+	return _op == cmp._op && _child == cmp._child;
+}
+
+bool BinaryExpression::equals_node(const Expr& other) const {
+	const BinaryExpression& cmp = static_cast<const BinaryExpression&>(other);
+	return _op == cmp._op && _left == cmp._left && _right == cmp._right;
+}
+
+bool Literal::equals_node(const Expr& other) const {
+	const Literal& cmp = static_cast<const Literal&>(other);
+	return _type == cmp._type && _value == cmp._value;
+}
+
+bool VarName::equals_node(const Expr& other) const {
+	const VarName& cmp = static_cast<const VarName&>(other);
+	return _symbol == cmp._symbol && _decl == cmp._decl && _type == cmp._type && _ignore_replace == cmp._ignore_replace;
+}
+
+bool Unknown::equals_node(const Expr& other) const {
+	return true;
+}
+
+bool SymbolicConstant::equals_node(const Expr& other) const {
+	const SymbolicConstant& cmp = static_cast<const SymbolicConstant&>(other);
+	return _decl == cmp._decl && _num == cmp._num;
+}
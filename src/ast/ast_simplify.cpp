@@ -0,0 +1,223 @@
+#include "ast/ast.hpp"
+
+#include <typeinfo>
+#include <climits>
+
+using namespace ast;
+
+
+const Literal* as_literal(const Expr& expr) {
+	// only plain constants; variables, unknowns and symbolic constants are derived from Literal as well
+	if (typeid(expr) != typeid(Literal)) return NULL;
+	return static_cast<const Literal*>(&expr);
+}
+
+bool is_unknown(const Expr& expr) {
+	return typeid(expr) == typeid(Unknown);
+}
+
+Expr* fold_constants(const binary_op& op, const Literal& lhs, const Literal& rhs) {
+	// NULL if the result is not representable (or would differ from the semantics of Z3, e.g. for negative divisions)
+	if (lhs.type() != rhs.type()) return NULL;
+	if (lhs.type() == bool_t) {
+		if (op == cmp_eq) return new Literal(lhs.bool_value() == rhs.bool_value());
+		if (op == cmp_neq) return new Literal(lhs.bool_value() != rhs.bool_value());
+		return NULL;
+	}
+
+	long long l = lhs.int_value();
+	long long r = rhs.int_value();
+	if (op == cmp_lt) return new Literal(l < r);
+	if (op == cmp_lte) return new Literal(l <= r);
+	if (op == cmp_gt) return new Literal(l > r);
+	if (op == cmp_gte) return new Literal(l >= r);
+	if (op == cmp_eq) return new Literal(l == r);
+	if (op == cmp_neq) return new Literal(l != r);
+
+	long long result;
+	if (op == ari_plus) result = l + r;
+	else if (op == ari_minus) result = l - r;
+	else if (op == ari_mult) result = l * r;
+	else if (op == ari_div && l >= 0 && r > 0) result = l / r;
+	else return NULL;
+	if (result < INT_MIN || result > INT_MAX) return NULL;
+	return new Literal((int) result);
+}
+
+bool is_int_literal(const Expr& expr, int value) {
+	const Literal* literal = as_literal(expr);
+	return literal != NULL && literal->type() == int_t && literal->int_value() == value;
+}
+
+bool complementary(const Expr& lhs, const Expr& rhs) {
+	auto neg = dynamic_cast<const UnaryExpression*>(&lhs);
+	if (neg != NULL && neg->op() == log_not && neg->child()->equals(rhs)) return true;
+	neg = dynamic_cast<const UnaryExpression*>(&rhs);
+	return neg != NULL && neg->op() == log_not && neg->child()->equals(lhs);
+}
+
+bool subsumes(const std::vector<std::shared_ptr<Expr>>& lhs, const std::vector<std::shared_ptr<Expr>>& rhs) {
+	// every operand of lhs is an operand of rhs
+	for (const auto& l : lhs) {
+		bool found = false;
+		for (const auto& r : rhs)
+			if ((found = l->equals(*r))) break;
+		if (!found) return false;
+	}
+	return true;
+}
+
+
+/******************************************************************************
+	Simplification
+ ******************************************************************************/
+
+Expr* Expr::simplify() const {
+	ReplaceCache cache;
+	auto result = simplified(cache);
+	return result ? result->copy() : copy();
+}
+
+std::shared_ptr<Expr> Expr::simplify(const std::shared_ptr<Expr>& expr, ReplaceCache& cache) {
+	// shared subexpressions are simplified only once
+	auto it = cache.find(expr.get());
+	if (it != cache.end()) return it->second.second;
+	auto simplified = expr->simplified(cache);
+	auto result = simplified ? simplified : expr;
+	cache.emplace(expr.get(), std::make_pair(expr, result));
+	return result;
+}
+
+
+std::shared_ptr<Expr> Conditional::simplified(ReplaceCache& cache) const {
+	// the form 'guard ? value : unknown' of abstract assignments is kept, even for constant guards
+	auto cond = simplify(_cond, cache);
+	auto yes = simplify(_if, cache);
+	auto no = simplify(_else, cache);
+	if (cond == _cond && yes == _if && no == _else) return NULL;
+	return intern(new Conditional(cond, yes, no));
+}
+
+std::shared_ptr<Expr> UnaryExpression::simplified(ReplaceCache& cache) const {
+	auto child = simplify(_child, cache);
+
+	const Literal* literal = as_literal(*child);
+	if (literal != NULL && _op == log_not && literal->type() == bool_t)
+		return intern(new Literal(!literal->bool_value()));
+	if (literal != NULL && _op == ari_neg && literal->type() == int_t && literal->int_value() != INT_MIN)
+		return intern(new Literal(-literal->int_value()));
+
+	auto inner = dynamic_cast<const UnaryExpression*>(child.get());
+	if (inner != NULL && inner->_op == _op) return inner->_child;
+
+	if (child == _child) return NULL;
+	return intern(new UnaryExpression(_op, child));
+}
+
+std::shared_ptr<Expr> BinaryExpression::simplified(ReplaceCache& cache) const {
+	if (_op == log_and || _op == log_or) return simplified_junction(cache);
+
+	auto left = simplify(_left, cache);
+	auto right = simplify(_right, cache);
+
+	const Literal* lhs = as_literal(*left);
+	const Literal* rhs = as_literal(*right);
+	if (lhs != NULL && rhs != NULL) {
+		Expr* folded = fold_constants(_op, *lhs, *rhs);
+		if (folded != NULL) return intern(folded);
+	}
+
+	if ((_op == ari_plus || _op == ari_minus) && is_int_literal(*right, 0)) return left;
+	if (_op == ari_plus && is_int_literal(*left, 0)) return right;
+	if ((_op == ari_mult || _op == ari_div) && is_int_literal(*right, 1)) return left;
+	if (_op == ari_mult && is_int_literal(*left, 1)) return right;
+
+	if (left == _left && right == _right) return NULL;
+	return intern(new BinaryExpression(_op, left, right));
+}
+
+void BinaryExpression::flatten(const binary_op& op, const std::shared_ptr<Expr>& expr, std::vector<std::shared_ptr<Expr>>& operands) {
+	auto junction = dynamic_cast<const BinaryExpression*>(expr.get());
+	if (junction == NULL || junction->_op != op) {
+		operands.push_back(expr);
+		return;
+	}
+	flatten(op, junction->_left, operands);
+	flatten(op, junction->_right, operands);
+}
+
+void BinaryExpression::collect(const binary_op& op, const std::shared_ptr<Expr>& expr, ReplaceCache& cache, std::vector<std::shared_ptr<Expr>>& operands) {
+	// the nodes of a chain are not simplified one by one (which would flatten the chain over and over again)
+	auto junction = dynamic_cast<const BinaryExpression*>(expr.get());
+	if (junction == NULL || junction->_op != op) {
+		flatten(op, simplify(expr, cache), operands);
+		return;
+	}
+	collect(op, junction->_left, cache, operands);
+	collect(op, junction->_right, cache, operands);
+}
+
+std::shared_ptr<Expr> BinaryExpression::balance(const binary_op& op, const std::vector<std::shared_ptr<Expr>>& operands, std::size_t begin, std::size_t end) {
+	assert(begin < end);
+	if (end - begin == 1) return operands.at(begin);
+	std::size_t mid = begin + (end - begin) / 2;
+	return intern(new BinaryExpression(op, balance(op, operands, begin, mid), balance(op, operands, mid, end)));
+}
+
+std::shared_ptr<Expr> BinaryExpression::simplified_junction(ReplaceCache& cache) const {
+	// conjunction: absorbing element false, neutral element true; disjunction vice versa
+	bool absorbing = _op == log_or;
+	const binary_op& dual = _op == log_and ? log_or : log_and;
+
+	std::vector<std::shared_ptr<Expr>> operands;
+	collect(_op, _left, cache, operands);
+	collect(_op, _right, cache, operands);
+
+	std::vector<std::shared_ptr<Expr>> remaining;
+	for (const auto& e : operands) {
+		const Literal* literal = as_literal(*e);
+		if (literal == NULL || literal->type() != bool_t) remaining.push_back(e);
+		else if (literal->bool_value() == absorbing) return intern(new Literal(absorbing));
+	}
+
+	// operands as sets of operands of the dual junction, e.g. the literals of the cubes of a disjunction;
+	// an operand is dropped if another one is a subset of it (note: duplicates are subsets of each other)
+	std::vector<std::vector<std::shared_ptr<Expr>>> duals(remaining.size());
+	for (std::size_t i = 0; i < remaining.size(); i++)
+		flatten(dual, remaining.at(i), duals.at(i));
+	std::vector<bool> dropped(remaining.size(), false);
+	for (std::size_t i = 0; i < remaining.size(); i++) {
+		// every occurrence of 'unknown' is a choice of its own
+		if (is_unknown(*remaining.at(i))) continue;
+		for (std::size_t j = 0; j < remaining.size() && !dropped.at(i); j++) {
+			if (i == j || dropped.at(j) || is_unknown(*remaining.at(j))) continue;
+			if (complementary(*remaining.at(i), *remaining.at(j))) return intern(new Literal(absorbing));
+			if (subsumes(duals.at(j), duals.at(i)) && (j < i || !subsumes(duals.at(i), duals.at(j)))) dropped.at(i) = true;
+		}
+	}
+
+	std::vector<std::shared_ptr<Expr>> result;
+	for (std::size_t i = 0; i < remaining.size(); i++)
+		if (!dropped.at(i)) result.push_back(remaining.at(i));
+	if (result.empty()) return intern(new Literal(!absorbing));
+
+	auto simplified = balance(_op, result, 0, result.size());
+	if (simplified->equals(*this)) return NULL;
+	return simplified;
+}
+
+std::shared_ptr<Expr> Literal::simplified(ReplaceCache& cache) const {
+	return NULL;
+}
+
+std::shared_ptr<Expr> VarName::simplified(ReplaceCache& cache) const {
+	return NULL;
+}
+
+std::shared_ptr<Expr> Unknown::simplified(ReplaceCache& cache) const {
+	return NULL;
+}
+
+std::shared_ptr<Expr> SymbolicConstant::simplified(ReplaceCache& cache) const {
+	return NULL;
+}
@@ -0,0 +1,312 @@
+#include "ast/ast.hpp"
+
+using namespace ast;
+
+
+bool intersects(const std::set<const VarDef*>& lhs, const std::set<const VarDef*>& rhs) {
+	for (const auto& e : lhs)
+		if (rhs.count(e)) return true;
+	return false;
+}
+
+
+/* collect_vars() */
+
+void Conditional::collect_vars(std::set<const VarDef*>& vars) const {
+	_cond->collect_vars(vars);
+	_if->collect_vars(vars);
+	_else->collect_vars(vars);
+}
+
+void UnaryExpression::collect_vars(std::set<const VarDef*>& vars) const {
+	_child->collect_vars(vars);
+}
+
+void BinaryExpression::collect_vars(std::set<const VarDef*>& vars) const {
+	_left->collect_vars(vars);
+	_right->collect_vars(vars);
+}
+
+void Literal::collect_vars(std::set<const VarDef*>& vars) const {
+}
+
+void VarName::collect_vars(std::set<const VarDef*>& vars) const {
+	assert(_decl != NULL);
+	vars.insert(_decl);
+}
+
+void Unknown::collect_vars(std::set<const VarDef*>& vars) const {
+}
+
+void SymbolicConstant::collect_vars(std::set<const VarDef*>& vars) const {
+	vars.insert(_decl);
+}
+
+
+/* slice() */
+
+bool Call::slice(std::set<const VarDef*>& relevant) const {
+	// frames are handled by cegar::slice_trace
+	return true;
+}
+
+bool Return::slice(std::set<const VarDef*>& relevant) const {
+	return true;
+}
+
+bool Assume::slice(std::set<const VarDef*>& relevant) const {
+	std::set<const VarDef*> vars;
+	_expr->collect_vars(vars);
+	if (!intersects(vars, relevant)) return false;
+	relevant.insert(vars.begin(), vars.end());
+	return true;
+}
+
+bool Assert::slice(std::set<const VarDef*>& relevant) const {
+	// con() is true, i.e. asserts do not constrain a trace
+	return false;
+}
+
+bool SimpleAssignment::slice(std::set<const VarDef*>& relevant) const {
+	if (!relevant.count(_var->decl())) return false;
+	relevant.erase(_var->decl());
+	_expr->collect_vars(relevant);
+	return true;
+}
+
+bool ParallelAssignment::slice(std::set<const VarDef*>& relevant) const {
+	bool keep = false;
+	for (const auto& v : _vars)
+		keep |= relevant.count(v->decl()) > 0;
+	if (!keep) return false;
+	// all right-hand sides are kept since con() encodes the assignment as a whole
+	for (const auto& v : _vars) relevant.erase(v->decl());
+	for (const auto& e : _exprs) e->collect_vars(relevant);
+	return true;
+}
+
+bool Skip::slice(std::set<const VarDef*>& relevant) const {
+	return false;
+}
+
+
+/* Program::slice() */
+
+bool reaches(const Relevance& relevance, const FunDef* from, const FunDef* to, std::set<const FunDef*>& visited) {
+	if (!visited.insert(from).second) return false;
+	auto it = relevance.calls.find(from);
+	if (it == relevance.calls.end()) return false;
+	for (const FunDef* callee : it->second)
+		if (callee == to || reaches(relevance, callee, to, visited)) return true;
+	return false;
+}
+
+void analyze(const std::vector<std::unique_ptr<FunDef>>& funs, Relevance& relevance) {
+	for (std::size_t pass = 0; true; pass++) {
+		std::size_t num_vars = relevance.vars.size();
+		std::size_t num_funs = relevance.funs.size();
+		for (const auto& f : funs)
+			f->relevant(relevance);
+
+		// the call graph is complete after the first pass; recursion may not terminate
+		if (pass == 0) {
+			for (const auto& f : funs) {
+				std::set<const FunDef*> visited;
+				if (reaches(relevance, f.get(), f.get(), visited)) relevance.funs.insert(f.get());
+			}
+		} else if (num_vars == relevance.vars.size() && num_funs == relevance.funs.size()) break;
+	}
+}
+
+std::size_t Program::slice() {
+	Relevance relevance;
+	analyze(_funs, relevance);
+
+	std::size_t removed = 0;
+	for (auto& f : _funs)
+		removed += f->prune(relevance);
+
+	// calls to functions that are not relevant are gone
+	std::vector<std::unique_ptr<FunDef>> funs;
+	for (auto& f : _funs) {
+		if (relevance.funs.count(f.get()) || f->name() == "main") {
+			funs.push_back(std::move(f));
+			continue;
+		}
+		_name2fun.erase(f->name());
+		_symbol2fun.erase(f->symbol());
+	}
+	_funs = std::move(funs);
+
+	std::vector<std::unique_ptr<VarDef>> vars;
+	for (auto& v : _vars) {
+		if (relevance.vars.count(v.get())) {
+			vars.push_back(std::move(v));
+			continue;
+		}
+		_name2var.erase(v->name());
+		_symbol2var.erase(v->symbol());
+	}
+	_vars = std::move(vars);
+
+	validate();
+	return removed;
+}
+
+std::vector<const FunDef*> Program::exclude_procedures() {
+	// with all globals being relevant, exactly the functions that may fail, block, diverge
+	// or modify globals (possibly through calls) are relevant
+	Relevance relevance;
+	for (const auto& v : _vars)
+		relevance.vars.insert(v.get());
+	analyze(_funs, relevance);
+
+	const FunDef* main = _name2fun.at("main");
+	std::set<const FunDef*> reachable;
+	std::vector<const FunDef*> work_list = { main };
+	while (!work_list.empty()) {
+		const FunDef* f = work_list.back();
+		work_list.pop_back();
+		if (!reachable.insert(f).second) continue;
+		auto it = relevance.calls.find(f);
+		if (it != relevance.calls.end()) work_list.insert(work_list.end(), it->second.begin(), it->second.end());
+	}
+
+	std::vector<const FunDef*> result;
+	for (auto& f : _funs) {
+		f->_excluded = f.get() != main && (!reachable.count(f.get()) || !relevance.funs.count(f.get()));
+		if (f->_excluded) result.push_back(f.get());
+	}
+	return result;
+}
+
+bool FunDef::relevant(Relevance& relevance) const {
+	relevance.current = this;
+	bool keep = false;
+	for (const auto& s : _stmts)
+		keep |= s->relevant(relevance);
+	if (keep) relevance.funs.insert(this);
+	return keep;
+}
+
+std::size_t prune(std::vector<std::unique_ptr<Statement>>& stmts, Relevance& relevance) {
+	std::size_t removed = 0;
+	std::vector<std::unique_ptr<Statement>> kept;
+	for (auto& s : stmts) {
+		if (!s->relevant(relevance)) {
+			removed++;
+			continue;
+		}
+		Statement* replacement = s->prune(relevance, removed);
+		if (replacement != NULL) s.reset(replacement);
+		kept.push_back(std::move(s));
+	}
+	stmts = std::move(kept);
+	return removed;
+}
+
+std::size_t FunDef::prune(Relevance& relevance) {
+	relevance.current = this;
+	std::size_t removed = ::prune(_stmts, relevance);
+
+	std::vector<std::unique_ptr<VarDef>> vars;
+	for (auto& v : _vars) {
+		if (relevance.vars.count(v.get())) {
+			vars.push_back(std::move(v));
+			continue;
+		}
+		_name2var.erase(v->name());
+		_symbol2var.erase(v->symbol());
+	}
+	_vars = std::move(vars);
+	return removed;
+}
+
+
+/* relevant() */
+
+bool While::relevant(Relevance& relevance) const {
+	// loops are kept as they may not terminate
+	for (const auto& s : _stmts)
+		s->relevant(relevance);
+	_cond->collect_vars(relevance.vars);
+	return true;
+}
+
+bool Ite::relevant(Relevance& relevance) const {
+	bool keep = false;
+	for (const auto& s : _if)
+		keep |= s->relevant(relevance);
+	for (const auto& s : _else)
+		keep |= s->relevant(relevance);
+	if (keep) _cond->collect_vars(relevance.vars);
+	return keep;
+}
+
+bool Call::relevant(Relevance& relevance) const {
+	relevance.calls[relevance.current].insert(_decl);
+	return relevance.funs.count(_decl) > 0;
+}
+
+bool AssBase::relevant(Relevance& relevance) const {
+	_expr->collect_vars(relevance.vars);
+	return true;
+}
+
+bool SimpleAssignment::relevant(Relevance& relevance) const {
+	if (!relevance.vars.count(_var->decl())) return false;
+	_expr->collect_vars(relevance.vars);
+	return true;
+}
+
+bool ParallelAssignment::relevant(Relevance& relevance) const {
+	bool keep = false;
+	for (std::size_t i = 0; i < _vars.size(); i++) {
+		if (!relevance.vars.count(_vars.at(i)->decl())) continue;
+		_exprs.at(i)->collect_vars(relevance.vars);
+		keep = true;
+	}
+	return keep;
+}
+
+bool Skip::relevant(Relevance& relevance) const {
+	return false;
+}
+
+bool DocString::relevant(Relevance& relevance) const {
+	return false;
+}
+
+
+/* prune() */
+
+Statement* Statement::prune(Relevance& relevance, std::size_t& removed) {
+	return NULL;
+}
+
+Statement* While::prune(Relevance& relevance, std::size_t& removed) {
+	removed += ::prune(_stmts, relevance);
+	return NULL;
+}
+
+Statement* Ite::prune(Relevance& relevance, std::size_t& removed) {
+	removed += ::prune(_if, relevance);
+	removed += ::prune(_else, relevance);
+	return NULL;
+}
+
+Statement* ParallelAssignment::prune(Relevance& relevance, std::size_t& removed) {
+	// the right-hand sides are evaluated before assigning; hence, components can be dropped independently
+	std::vector<std::unique_ptr<VarName>> vars;
+	std::vector<std::unique_ptr<Expr>> exprs;
+	for (std::size_t i = 0; i < _vars.size(); i++) {
+		if (!relevance.vars.count(_vars.at(i)->decl())) continue;
+		vars.push_back(std::move(_vars.at(i)));
+		exprs.push_back(std::move(_exprs.at(i)));
+	}
+	_vars = std::move(vars);
+	_exprs = std::move(exprs);
+	assert(_vars.size() > 0);
+	if (_vars.size() > 1) return NULL;
+	return new SimpleAssignment(_vars.front().release(), _exprs.front().release());
+}
@@ -0,0 +1,63 @@
+#include "ast/ast.hpp"
+
+using namespace ast;
+
+
+Expr* Expr::ssa(const VersionMap& versions) const {
+	ReplaceCache cache;
+	Expr* result = rebuild(versions, cache);
+	return result != NULL ? result : copy();
+}
+
+std::shared_ptr<Expr> Expr::ssa(const std::shared_ptr<Expr>& expr, const VersionMap& versions, ReplaceCache& cache) {
+	// subexpressions without variables are kept as they are; shared ones are renamed only once
+	if (!expr->contains_any_var()) return expr;
+	auto it = cache.find(expr.get());
+	if (it != cache.end()) return it->second.second;
+	Expr* rebuilt = expr->rebuild(versions, cache);
+	auto result = rebuilt != NULL ? intern(rebuilt) : expr;
+	cache.emplace(expr.get(), std::make_pair(expr, result));
+	return result;
+}
+
+
+Expr* Conditional::rebuild(const VersionMap& versions, ReplaceCache& cache) const {
+	auto cond = ssa(_cond, versions, cache);
+	auto yes = ssa(_if, versions, cache);
+	auto no = ssa(_else, versions, cache);
+	if (cond == _cond && yes == _if && no == _else) return NULL;
+	return new Conditional(cond, yes, no);
+}
+
+Expr* UnaryExpression::rebuild(const VersionMap& versions, ReplaceCache& cache) const {
+	auto child = ssa(_child, versions, cache);
+	if (child == _child) return NULL;
+	return new UnaryExpression(_op, child);
+}
+
+Expr* BinaryExpression::rebuild(const VersionMap& versions, ReplaceCache& cache) const {
+	auto left = ssa(_left, versions, cache);
+	auto right = ssa(_right, versions, cache);
+	if (left == _left && right == _right) return NULL;
+	return new BinaryExpression(_op, left, right);
+}
+
+Expr* Literal::rebuild(const VersionMap& versions, ReplaceCache& cache) const {
+	return NULL;
+}
+
+Expr* VarName::rebuild(const VersionMap& versions, ReplaceCache& cache) const {
+	if (_ignore_replace > 0) return NULL;
+	const std::size_t* version = versions.find(_decl);
+	if (version == NULL) return NULL;
+	return new SymbolicConstant(_decl, *version);
+}
+
+Expr* Unknown::rebuild(const VersionMap& versions, ReplaceCache& cache) const {
+	return NULL;
+}
+
+Expr* SymbolicConstant::rebuild(const VersionMap& versions, ReplaceCache& cache) const {
+	assert(false);
+	return NULL;
+}
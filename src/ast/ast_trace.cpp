@@ -1,5 +1,6 @@
 #include "ast/ast.hpp"
 #include "ast/trace.hpp"
+#include "checks.hpp"
 
 using namespace ast;
 
@@ -16,8 +17,8 @@ std::vector<const TraceableStatement*> AssBase::flat_trace(const Program& abstra
 }
 
 std::vector<const TraceableStatement*> Call::flat_trace(const Program& abstract, const symbolic::ControlFlowGraph& cfg, const BDD preconf, const BDD postconf, const BDD bounds, const BDD ignored_edges) const {
-	assert(cfg.decode(preconf) == _cfg_call->call());
-	assert(cfg.decode(postconf) == _cfg_call->retrn());
+	assert_expensive(cfg.decode(preconf) == _cfg_call.call());
+	assert_expensive(cfg.decode(postconf) == _cfg_call.retrn());
 	// TODO: add call/return statements to trace!
 	auto result = _decl->flat_trace(abstract, cfg, preconf, postconf, bounds, ignored_edges);
 	result.insert(result.begin(), this);
@@ -25,16 +26,29 @@ std::vector<const TraceableStatement*> Call::flat_trace(const Program& abstract,
 	return result;
 }
 
+std::vector<const TraceableStatement*> LargeBlock::flat_trace(const Program& abstract, const symbolic::ControlFlowGraph& cfg, const BDD preconf, const BDD postconf, const BDD bounds, const BDD ignored_edges) const {
+	// the composed statements do not depend on the configurations
+	std::vector<const TraceableStatement*> result;
+	for (const TraceableStatement* s : _stmts) {
+		auto sub = s->flat_trace(abstract, cfg, preconf, postconf, bounds, ignored_edges);
+		result.insert(result.end(), sub.begin(), sub.end());
+	}
+	return result;
+}
+
 std::vector<const TraceableStatement*> FunDef::flat_trace(const Program& abstract, const symbolic::ControlFlowGraph& cfg, const BDD callconf, const BDD returnconf, const BDD bounds, const BDD edgeignore) const {
 	// remove summary edge taken for the path being currently handled
 	// -> this prevents looping/infinite Hoare Proofs
 	// this is the only sufficient solution, i.e. just pruning some configuration is not sufficient,
 	// since procedures of the abstracted program are potentially non-deterministically and thus
 	// only the call-return relation (summary edge) properly characterises the function sequence
-	const auto np2p = symbolic::concat({cfg.stateVariablesPrime(), cfg.programVariablesPrime(), cfg.stateVariablesPrime(), cfg.programVariablesPrime(), cfg.globalVariablesRel()});
+	const auto np2p = symbolic::concat({cfg.stateVariablesPrime(), cfg.programVariablesPrime(), cfg.stateVariablesPrime(), cfg.programVariablesPrime(), cfg.globalVariablesRel(), cfg.programVariablesIntermediate()});
 	auto edge_taken = callconf * returnconf.VectorCompose(np2p);
-	assert((cfg.transitionRelation() & edge_taken) != cfg.zero());
+	assert_expensive((cfg.transitionRelation() & edge_taken) != cfg.zero());
 	auto ignored_edges = edgeignore + edge_taken;
+	// with large blocks, a path from entry to exit that descends into a (recursive) call without returning
+	// from it may be shorter than the one taking the summary edge
+	if (cfg.composable()) ignored_edges += cfg.callRelation();
 
 	// prepare variable removal to avoid overhead
 	auto nonglobvars = symbolic::multiply(cfg.one(), {cfg.stateVariables(), cfg.localVariables()});
@@ -47,10 +61,10 @@ std::vector<const TraceableStatement*> FunDef::flat_trace(const Program& abstrac
 	BDD val_out = globalval(returnconf);
 
 	// compute procedure entry/exit points according to summary edge for callconf/returnconf
-	BDD src = cfg.encode(_cfg_proc->entry()) * val_in;
-	BDD dst = cfg.encode(_cfg_proc->exit()) * val_out;
-	assert((src & bounds) != cfg.zero());
-	assert((dst & bounds) != cfg.zero());
+	BDD src = cfg.encode(_cfg_proc.entry()) * val_in;
+	BDD dst = cfg.encode(_cfg_proc.exit()) * val_out;
+	assert_expensive((src & bounds) != cfg.zero());
+	assert_expensive((dst & bounds) != cfg.zero());
 
 	// generate flat "sub" trace
 	auto trace = ast::flat_trace(abstract, cfg, src, dst, bounds, ignored_edges);
@@ -0,0 +1,232 @@
+#include <set>
+#include <algorithm>
+#include "ast/ast.hpp"
+
+using namespace ast;
+
+
+/******************************************************************************
+	UNROLLING
+ ******************************************************************************/
+
+Unrolling::Unrolling(z3::context& context, std::size_t bound, lvalmap_t& top)
+                    : _context(context), _bound(bound), _top(top), _state({ context.bool_val(true), VersionMap() }), _num_holes(0) {}
+
+z3::expr Unrolling::value(const VarDef* var, const VersionMap& lvalmap) const {
+	// variables never assigned so far keep their plain name, cf. TraceableStatement::con
+	const std::size_t* version = lvalmap.find(var);
+	if (version == NULL) return VarName(var).z3(_context);
+	else return SymbolicConstant(var, *version).z3(_context);
+}
+
+z3::expr Unrolling::eval(const Expr& expr) {
+	Assume tmp(expr.copy());
+	std::unique_ptr<Expr> sub(tmp.con(_state.lvalmap));
+	return sub->z3(_context);
+}
+
+void Unrolling::join(const std::vector<State>& states) {
+	assert(states.size() > 0);
+	if (states.size() == 1) {
+		_state = states.front();
+		return;
+	}
+
+	z3::expr guard = _context.bool_val(false);
+	std::set<const VarDef*> vars;
+	for (const State& s : states) {
+		guard = guard || s.guard;
+		for (const auto& e : s.lvalmap.entries()) vars.insert(e.first);
+	}
+
+	VersionMap lvalmap;
+	for (const VarDef* var : vars) {
+		bool same = true;
+		for (const State& s : states)
+			same &= s.lvalmap.count(var) > 0 && states.front().lvalmap.count(var) > 0 && s.lvalmap.at(var) == states.front().lvalmap.at(var);
+		if (same) {
+			lvalmap.set(var, states.front().lvalmap.at(var));
+			continue;
+		}
+
+		// phi: fresh constant taking the value of the branch that was executed
+		std::size_t index = ++_top[var];
+		z3::expr phi = SymbolicConstant(var, index).z3(_context);
+		for (const State& s : states)
+			_constraints.push_back(z3::implies(s.guard, phi == value(var, s.lvalmap)));
+		lvalmap.set(var, index);
+	}
+
+	_state = { guard, lvalmap };
+}
+
+void Unrolling::assign(const std::vector<const VarDef*>& vars, const TraceableStatement& stmt) {
+	// TraceableStatement::con increments the current index; make sure that it yields an unused one
+	auto& lvalmap = _state.lvalmap;
+	for (const VarDef* var : vars) {
+		std::size_t current = lvalmap.count(var) > 0 ? lvalmap.at(var) : 0;
+		if (current == _top[var]) continue;
+		std::size_t index = ++_top[var];
+		_constraints.push_back(SymbolicConstant(var, index).z3(_context) == value(var, lvalmap));
+		lvalmap.set(var, index);
+	}
+
+	std::unique_ptr<Expr> con(stmt.con(lvalmap));
+	_constraints.push_back(con->z3(_context));
+
+	for (const VarDef* var : vars)
+		_top[var] = std::max(_top[var], lvalmap.at(var));
+}
+
+void Unrolling::check(const Assert& stmt, const z3::expr& cond) {
+	// executions passing the assertion continue
+	_violations.push_back(std::make_pair(&stmt, _state.guard && !cond));
+	assume(cond);
+}
+
+void Unrolling::suspend(const While* loop, const Call* call) {
+	// all variables in scope are initialized, hence the versioned ones are those the hole may modify
+	z3::expr reached = _context.bool_const(("unroll$hole$" + std::to_string(_num_holes++)).c_str());
+	VersionMap post;
+	for (const auto& e : _state.lvalmap.entries())
+		post.set(e.first, ++_top[e.first]);
+	_holes.push_back({ loop, call, _stack, _state, reached, post });
+	_state = { reached, post };
+}
+
+void Unrolling::extend() {
+	_bound++;
+	std::vector<Hole> holes;
+	holes.swap(_holes);
+	for (const Hole& hole : holes) {
+		_stack = hole.stack;
+		_state = hole.pre;
+		if (hole.loop != NULL) hole.loop->resume(*this);
+		else hole.call->unroll(*this);
+
+		// define the constants executions continue with after the hole
+		_constraints.push_back(hole.reached == _state.guard);
+		for (const auto& e : hole.post.entries())
+			_constraints.push_back(z3::implies(_state.guard, SymbolicConstant(e.first, e.second).z3(_context) == value(e.first, _state.lvalmap)));
+	}
+}
+
+std::vector<z3::expr> Unrolling::cutoffs() const {
+	std::vector<z3::expr> result;
+	for (const Hole& hole : _holes) result.push_back(hole.pre.guard);
+	return result;
+}
+
+std::vector<z3::expr> Unrolling::resumptions() const {
+	std::vector<z3::expr> result;
+	for (const Hole& hole : _holes) result.push_back(hole.reached);
+	return result;
+}
+
+bool Unrolling::enter(const FunDef* fun) {
+	if ((std::size_t) std::count(_stack.begin(), _stack.end(), fun) > _bound) return false;
+	_stack.push_back(fun);
+	return true;
+}
+
+void Unrolling::leave(const State& caller) {
+	_stack.pop_back();
+	// local variables are restored (they may belong to the same function in case of recursion)
+	VersionMap lvalmap;
+	for (const auto& e : _state.lvalmap.entries())
+		if (!e.first->is_local()) lvalmap.set(e.first, e.second);
+	for (const auto& e : caller.lvalmap.entries())
+		if (e.first->is_local()) lvalmap.set(e.first, e.second);
+	_state.lvalmap = lvalmap;
+}
+
+
+/******************************************************************************
+	UNROLL
+ ******************************************************************************/
+
+void FunDef::unroll(Unrolling& unrolling) const {
+	for (const auto& s : _stmts)
+		s->unroll(unrolling);
+}
+
+void While::unroll(Unrolling& unrolling) const {
+	unroll(unrolling, unrolling.bound());
+}
+
+void While::unroll(Unrolling& unrolling, std::size_t iterations) const {
+	std::vector<Unrolling::State> exits;
+	for (std::size_t i = 0; ; i++) {
+		z3::expr cond = unrolling.eval(*_cond);
+		Unrolling::State exit = unrolling.state();
+		exit.guard = exit.guard && !cond;
+		exits.push_back(exit);
+
+		unrolling.assume(cond);
+		if (i == iterations) {
+			// executions leaving the loop later continue after the hole
+			unrolling.suspend(*this);
+			exits.push_back(unrolling.state());
+			break;
+		}
+		for (const auto& s : _stmts)
+			s->unroll(unrolling);
+	}
+	unrolling.join(exits);
+}
+
+void While::resume(Unrolling& unrolling) const {
+	for (const auto& s : _stmts)
+		s->unroll(unrolling);
+	unroll(unrolling, 0);
+}
+
+void Ite::unroll(Unrolling& unrolling) const {
+	z3::expr cond = unrolling.eval(*_cond);
+	Unrolling::State pre = unrolling.state();
+
+	unrolling.assume(cond);
+	for (const auto& s : _if)
+		s->unroll(unrolling);
+	Unrolling::State if_post = unrolling.state();
+
+	unrolling.restore(pre);
+	unrolling.assume(!cond);
+	for (const auto& s : _else)
+		s->unroll(unrolling);
+	Unrolling::State else_post = unrolling.state();
+
+	unrolling.join({ if_post, else_post });
+}
+
+void Call::unroll(Unrolling& unrolling) const {
+	if (!unrolling.enter(_decl)) {
+		unrolling.suspend(*this);
+		return;
+	}
+	Unrolling::State caller = unrolling.state();
+	_decl->unroll(unrolling);
+	unrolling.leave(caller);
+}
+
+void ParallelAssignment::unroll(Unrolling& unrolling) const {
+	std::vector<const VarDef*> vars;
+	for (const auto& v : _vars) vars.push_back(v->decl());
+	unrolling.assign(vars, *this);
+}
+
+void SimpleAssignment::unroll(Unrolling& unrolling) const {
+	unrolling.assign({ _var->decl() }, *this);
+}
+
+void Assume::unroll(Unrolling& unrolling) const {
+	unrolling.assume(unrolling.eval(*_expr));
+}
+
+void Assert::unroll(Unrolling& unrolling) const {
+	unrolling.check(*this, unrolling.eval(*_expr));
+}
+
+void Skip::unroll(Unrolling& unrolling) const {}
+
+void DocString::unroll(Unrolling& unrolling) const {}
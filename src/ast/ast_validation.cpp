@@ -56,10 +56,9 @@ void Ite::validate(const Program& prog, const FunDef& fun) {
 }
 
 void Call::validate(const Program& prog, const FunDef& fun) {
-	if (prog.name2fun().count(_funname) == 0)
+	_decl = prog.fun(_funsymbol);
+	if (_decl == NULL)
 		throw ValidationError("Call to unknown function '" + _funname + "()' in '" + fun.name() + "()'.");
-	else
-		_decl = prog.name2fun().at(_funname);
 }
 
 void SimpleAssignment::validate(const Program& prog, const FunDef& fun) {
@@ -100,9 +99,11 @@ void Skip::validate(const Program& prog, const FunDef& fun) {}
 /**** Expressions ****/
 
 void Conditional::validate(const Program& prog, const FunDef& fun) {
-	_cond->validate(prog, fun);
-	_if->validate(prog, fun);
-	_else->validate(prog, fun);
+	validate_child(_cond, prog, fun);
+	validate_child(_if, prog, fun);
+	validate_child(_else, prog, fun);
+	rehash();
+	summarize({ _cond.get(), _if.get(), _else.get() });
 	if (_cond->type() != bool_t)
 		throw ValidationError("Condition of conditional expression in '" + fun.name() + "()' not of type 'bool'.");
 	if (_if->type() != bool_t)
@@ -112,14 +113,18 @@ void Conditional::validate(const Program& prog, const FunDef& fun) {
 }
 
 void UnaryExpression::validate(const Program& prog, const FunDef& fun) {
-	_child->validate(prog, fun);
+	validate_child(_child, prog, fun);
+	rehash();
+	summarize({ _child.get() });
 	if (_child->type() != type())
 		throw ValidationError("Unary expression in function '" + fun.name() + "()' wrongly typed.");
 }
 
 void BinaryExpression::validate(const Program& prog, const FunDef& fun) {
-	_left->validate(prog, fun);
-	_right->validate(prog, fun);
+	validate_child(_left, prog, fun);
+	validate_child(_right, prog, fun);
+	rehash();
+	summarize({ _left.get(), _right.get() });
 	if (_left->type() != _op.subtype() || _right->type() != _op.subtype())
 		throw ValidationError("Binary expression in function '" + fun.name() + "()' wrongly typed.");
 }
@@ -127,13 +132,13 @@ void BinaryExpression::validate(const Program& prog, const FunDef& fun) {
 void Literal::validate(const Program& prog, const FunDef& fun) {}
 
 void VarName::validate(const Program& prog, const FunDef& fun) {
-	if (prog.name2var().count(_value) > 0)
-		_decl = prog.name2var().at(_value);
-	else if (fun.name2var().count(_value) > 0)
-		_decl = fun.name2var().at(_value);
-	else
-		throw ValidationError("Undeclared variable '" + _value + "' in function '" + fun.name() + "()'.");
+	_decl = prog.var(_symbol);
+	if (_decl == NULL) _decl = fun.var(_symbol);
+	if (_decl == NULL)
+		throw ValidationError("Undeclared variable '" + name() + "' in function '" + fun.name() + "()'.");
 	_type = _decl->type();
+	rehash();
+	summarize();
 }
 
 void Unknown::validate(const Program& prog, const FunDef& fun) {}
@@ -14,15 +14,15 @@ Expr* Return::wp(const Expr& phi) const {
 }
 
 Expr* ParallelAssignment::wp(const Expr& phi) const {
-	std::map<std::string, const Expr*> repl;
+	Expr::Substitution repl;
 	for (std::size_t i = 0; i < _vars.size(); i++)
-		repl[_vars.at(i)->name()] = _exprs.at(i).get();
+		repl[_vars.at(i)->symbol()] = _exprs.at(i).get();
 	return phi.replace(repl);
 }
 
 Expr* SimpleAssignment::wp(const Expr& phi) const {
-	std::map<std::string, const Expr*> repl;
-	repl[_var->name()] = _expr.get();
+	Expr::Substitution repl;
+	repl[_var->symbol()] = _expr.get();
 	return phi.replace(repl);
 }
 
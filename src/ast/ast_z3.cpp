@@ -1,5 +1,6 @@
 #include "ast/ast.hpp"
 #include "ast/abstraction_utils.hpp"
+#include "ast/term_cache.hpp"
 
 using namespace ast;
 
@@ -7,18 +8,18 @@ using namespace ast;
 /**** Expressions ****/
 
 z3::expr Conditional::z3(z3::context& context) const {
-	return z3::to_expr(context, Z3_mk_ite(context, _cond->z3(context), _if->z3(context), _else->z3(context)));
+	return z3::to_expr(context, Z3_mk_ite(context, z3_term(_cond, context), z3_term(_if, context), z3_term(_else, context)));
 }
 
 z3::expr UnaryExpression::z3(z3::context& context) const {
-	if (_op == log_not) return !_child->z3(context);
-	else if (_op == ari_neg) return -_child->z3(context);
+	if (_op == log_not) return !z3_term(_child, context);
+	else if (_op == ari_neg) return -z3_term(_child, context);
 	else assert(false);
 }
 
 z3::expr BinaryExpression::z3(z3::context& context) const {
-	auto lhs = _left->z3(context);
-	auto rhs = _right->z3(context);
+	auto lhs = z3_term(_left, context);
+	auto rhs = z3_term(_right, context);
 	// TODO: check whether we used proper operator overloads
 	if (_op == ari_plus) return lhs + rhs;
 	else if (_op == ari_minus) return lhs - rhs;
@@ -43,7 +44,9 @@ z3::expr Literal::z3(z3::context& context) const {
 
 z3::expr VarName::z3(z3::context& context) const {
 	assert(_decl != NULL);
-	auto name = _value.c_str();
+	TermCache* cache = TermCache::current(context);
+	if (cache != NULL) return cache->var(*_decl);
+	auto name = this->name().c_str();
 	auto type = _decl->type();
 	if (type == bool_t) return context.bool_const(name);
 	else if (type == int_t) return context.int_const(name);
@@ -59,6 +62,8 @@ z3::expr SymbolicConstant::z3(z3::context& context) const {
 	// return mk_z3var(context, _var->decl(), "", postfix);
 	// TODO: this breaks in case of boolean variables
 	assert(_decl != NULL);
+	TermCache* cache = TermCache::current(context);
+	if (cache != NULL) return cache->constant(*_decl, _num);
 	auto fun = _decl->function();
 	auto prefix = fun == NULL ? "global" : fun->name();
 	auto varname = _decl->name();
@@ -0,0 +1,71 @@
+#include "ast/query_cache.hpp"
+
+#include <vector>
+#include <sstream>
+
+using namespace ast;
+
+
+QueryCache& QueryCache::instance() {
+	static QueryCache cache;
+	return cache;
+}
+
+std::size_t serialize(const z3::expr& expr, std::unordered_map<unsigned int, std::size_t>& index, std::ostream& os) {
+	unsigned int id = Z3_get_ast_id(expr.ctx(), expr);
+	auto it = index.find(id);
+	if (it != index.end()) return it->second;
+
+	std::vector<std::size_t> args;
+	if (expr.is_app())
+		for (unsigned int i = 0; i < expr.num_args(); i++)
+			args.push_back(serialize(expr.arg(i), index, os));
+
+	// subterms are numbered in the order of their first occurrence (instead of by their Z3 id);
+	// shared subterms are serialized only once
+	if (expr.is_numeral()) os << Z3_get_numeral_string(expr.ctx(), expr);
+	else if (expr.is_app()) os << expr.decl().name().str();
+	else os << Z3_ast_to_string(expr.ctx(), expr);
+	os << ":" << Z3_sort_to_string(expr.ctx(), expr.get_sort());
+	for (std::size_t arg : args) os << " #" << arg;
+	os << ";";
+
+	std::size_t result = index.size();
+	index.emplace(id, result);
+	return result;
+}
+
+std::string QueryCache::key(const z3::expr& formula) {
+	std::unordered_map<unsigned int, std::size_t> index;
+	std::stringstream result;
+	serialize(formula, index, result);
+	return result.str();
+}
+
+bool QueryCache::lookup(const std::string& key, bool& result) {
+	auto it = _results.find(key);
+	if (it == _results.end()) {
+		_misses++;
+		return false;
+	}
+	_hits++;
+	result = it->second;
+	return true;
+}
+
+void QueryCache::store(const std::string& key, bool result) {
+	_results[key] = result;
+}
+
+void QueryCache::load(std::istream& is) {
+	// format: one query per line, prefixed by its result (0 or 1)
+	std::string line;
+	while (std::getline(is, line))
+		if (line.size() > 2 && (line[0] == '0' || line[0] == '1') && line[1] == ' ')
+			_results.emplace(line.substr(2), line[0] == '1');
+}
+
+void QueryCache::save(std::ostream& os) const {
+	for (const auto& e : _results)
+		os << (e.second ? '1' : '0') << ' ' << e.first << std::endl;
+}
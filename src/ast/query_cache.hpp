@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <iostream>
+#include <unordered_map>
+#include "z3++.h"
+
+
+namespace ast {
+
+
+	/**
+	 * @brief Results of SMT queries shared by all parts of a verification run.
+	 * @details Queries are identified by a canonical serialization of the checked formula
+	 *          (incl. the sorts of its constants). Hence, structurally identical formulas
+	 *          hit the cache even if they stem from different ```z3::context``` s or runs.
+	 *
+	 * @see ast::is_taut
+	 */
+	class QueryCache {
+		private:
+			std::unordered_map<std::string, bool> _results;
+			std::size_t _hits = 0;
+			std::size_t _misses = 0;
+
+		public:
+			/**
+			 * @brief The cache used by ```ast::is_taut```.
+			 */
+			static QueryCache& instance();
+
+			/**
+			 * @brief Computes the canonical key of the given formula.
+			 */
+			static std::string key(const z3::expr& formula);
+
+			/**
+			 * @brief Looks up the result for ```key``` and stores it in ```result``` if present.
+			 * @return ```true``` iff. the cache contains a result for ```key```
+			 */
+			bool lookup(const std::string& key, bool& result);
+			void store(const std::string& key, bool result);
+
+			std::size_t size() const { return _results.size(); }
+			std::size_t hits() const { return _hits; }
+			std::size_t misses() const { return _misses; }
+
+			/**
+			 * @brief Adds the entries written by ```QueryCache::save```; existing entries are kept.
+			 */
+			void load(std::istream& is);
+			void save(std::ostream& os) const;
+	};
+
+
+}
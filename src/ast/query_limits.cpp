@@ -0,0 +1,26 @@
+#include "ast/query_limits.hpp"
+
+using namespace ast;
+
+
+QueryLimits& QueryLimits::instance() {
+	static QueryLimits limits;
+	return limits;
+}
+
+void QueryLimits::set(unsigned int timeout, unsigned int rlimit) {
+	_timeout = timeout;
+	_rlimit = rlimit;
+}
+
+z3::params QueryLimits::params(z3::context& context) const {
+	z3::params result(context);
+	if (_timeout > 0) result.set("timeout", _timeout);
+	if (_rlimit > 0) result.set("rlimit", _rlimit);
+	return result;
+}
+
+void QueryLimits::apply(z3::solver& solver) const {
+	if (!enabled()) return;
+	solver.set(params(solver.ctx()));
+}
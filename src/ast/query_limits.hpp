@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include "z3++.h"
+
+
+namespace ast {
+
+
+	/**
+	 * @brief Time and resource limits for individual solver queries.
+	 * @details Limits are applied to the queries of the predicate abstraction and of the
+	 *          interpolation only; both degrade gracefully if a query is given up:
+	 *          a cube that cannot be shown to imply a formula is treated as not implying it,
+	 *          an interpolant that cannot be computed is dropped (i.e. it is ```true```).
+	 *          Either way, precision is lost but not soundness. Such fallbacks are counted.
+	 *          Without limits (the default), queries run to completion.
+	 */
+	class QueryLimits {
+		private:
+			unsigned int _timeout = 0;
+			unsigned int _rlimit = 0;
+			std::size_t _abstraction_fallbacks = 0;
+			std::size_t _interpolation_fallbacks = 0;
+
+		public:
+			/**
+			 * @brief The limits used by ```ast::Program::abstract``` and ```cegar::compute_interpolants```.
+			 */
+			static QueryLimits& instance();
+
+			/**
+			 * @param timeout wall time per query in milliseconds; 0 for none
+			 * @param rlimit Z3 resource limit per query; 0 for none
+			 */
+			void set(unsigned int timeout, unsigned int rlimit);
+			bool enabled() const { return _timeout > 0 || _rlimit > 0; }
+
+			/**
+			 * @brief Solver parameters enforcing the limits.
+			 */
+			z3::params params(z3::context& context) const;
+			void apply(z3::solver& solver) const;
+
+			void abstraction_fallback() { _abstraction_fallbacks++; }
+			void interpolation_fallback() { _interpolation_fallbacks++; }
+			std::size_t abstraction_fallbacks() const { return _abstraction_fallbacks; }
+			std::size_t interpolation_fallbacks() const { return _interpolation_fallbacks; }
+	};
+
+
+}
@@ -0,0 +1,66 @@
+#include "ast/query_log.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <sys/stat.h>
+
+using namespace ast;
+
+
+std::string single_line(std::string text) {
+	for (char& c : text)
+		if (c == '\n' || c == '\t') c = ' ';
+	std::size_t begin = text.find_first_not_of(' ');
+	if (begin == std::string::npos) return "-";
+	return text.substr(begin, text.find_last_not_of(' ') - begin + 1);
+}
+
+
+/******************************************************************************
+	QUERY LOG
+ ******************************************************************************/
+
+QueryLog& QueryLog::instance() {
+	static QueryLog log;
+	return log;
+}
+
+void QueryLog::open(std::string directory) {
+	mkdir(directory.c_str(), 0755);
+	_directory = directory;
+	_count = 0;
+}
+
+void QueryLog::record(const z3::expr& formula, std::string result, double seconds) {
+	if (!enabled()) return;
+
+	std::stringstream filename;
+	filename << _directory << "/query_" << std::setw(6) << std::setfill('0') << _count++ << ".smt2";
+
+	std::ofstream out(filename.str());
+	out << "; origin: " << single_line(_origin) << std::endl;
+	out << "; statement: " << single_line(_statement) << std::endl;
+	out << "; result: " << result << std::endl;
+	out << "; time: " << seconds << "s" << std::endl;
+	out << Z3_benchmark_to_smtlib_string(formula.ctx(), "", "", result.c_str(), "", 0, NULL, formula);
+}
+
+
+/******************************************************************************
+	QUERY ORIGIN
+ ******************************************************************************/
+
+QueryOrigin::QueryOrigin(std::string origin, std::string statement) {
+	QueryLog& log = QueryLog::instance();
+	_origin = log._origin;
+	_statement = log._statement;
+	log._origin = origin;
+	log._statement = statement;
+}
+
+QueryOrigin::~QueryOrigin() {
+	QueryLog& log = QueryLog::instance();
+	log._origin = _origin;
+	log._statement = _statement;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include "z3++.h"
+
+
+namespace ast {
+
+
+	/**
+	 * @brief Records solver queries as SMT-LIB2 files for offline analysis.
+	 * @details Every query is written to its own file ```query_<n>.smt2``` in the log directory.
+	 *          A header of comments states the origin of the query (e.g. abstraction,
+	 *          spurious check, interpolation), the statement it was issued for, its result and
+	 *          the wall time it took. Logging is disabled unless a directory is opened.
+	 *
+	 * @see ast::QueryOrigin
+	 */
+	class QueryLog {
+		private:
+			std::string _directory;
+			std::size_t _count = 0;
+			std::string _origin;
+			std::string _statement;
+
+		public:
+			/**
+			 * @brief The log used by ```ast::is_taut``` and ```cegar::interpolate```.
+			 */
+			static QueryLog& instance();
+
+			/**
+			 * @brief Enables logging to the given directory; the directory is created if necessary.
+			 * @details Numbering of the files starts afresh, e.g. for a forked process logging on its own.
+			 */
+			void open(std::string directory);
+			bool enabled() const { return !_directory.empty(); }
+			const std::string& directory() const { return _directory; }
+			std::size_t size() const { return _count; }
+
+			/**
+			 * @brief Writes a query checking the satisfiability of ```formula```.
+			 * @param formula the asserted formula
+			 * @param result ```sat```, ```unsat``` or ```unknown```
+			 * @param seconds wall time taken by the solver
+			 */
+			void record(const z3::expr& formula, std::string result, double seconds);
+
+		friend class QueryOrigin;
+	};
+
+
+	/**
+	 * @brief Sets origin and statement of the queries recorded in a ```QueryLog``` while in scope.
+	 */
+	class QueryOrigin {
+		private:
+			std::string _origin;
+			std::string _statement;
+
+		public:
+			QueryOrigin(std::string origin, std::string statement="");
+			~QueryOrigin();
+	};
+
+
+}
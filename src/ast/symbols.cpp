@@ -0,0 +1,72 @@
+#include "ast/symbols.hpp"
+
+#include <algorithm>
+
+using namespace ast;
+
+
+SymbolTable& SymbolTable::instance() {
+	static SymbolTable table;
+	return table;
+}
+
+symbol_t SymbolTable::intern(const std::string& name) {
+	auto it = _ids.find(name);
+	if (it != _ids.end()) return it->second;
+	symbol_t result = _names.size();
+	_names.push_back(name);
+	_singletons.push_back(SymbolSet(result));
+	_ids.emplace(name, result);
+	return result;
+}
+
+
+/******************************************************************************
+	SYMBOL SET
+ ******************************************************************************/
+
+#define WORD_BITS 64
+
+SymbolSet::SymbolSet(symbol_t symbol) {
+	std::vector<std::uint64_t>* words = new std::vector<std::uint64_t>(symbol / WORD_BITS + 1, 0);
+	words->back() = std::uint64_t(1) << (symbol % WORD_BITS);
+	_words.reset(words);
+}
+
+bool SymbolSet::contains(symbol_t symbol) const {
+	if (empty() || symbol / WORD_BITS >= _words->size()) return false;
+	return (_words->at(symbol / WORD_BITS) >> (symbol % WORD_BITS)) & 1;
+}
+
+bool SymbolSet::includes(const SymbolSet& other) const {
+	if (other.empty() || _words == other._words) return true;
+	if (empty()) return false;
+	for (std::size_t i = 0; i < other._words->size(); i++) {
+		std::uint64_t word = i < _words->size() ? _words->at(i) : 0;
+		if ((other._words->at(i) & ~word) != 0) return false;
+	}
+	return true;
+}
+
+bool SymbolSet::intersects(const SymbolSet& other) const {
+	if (empty() || other.empty()) return false;
+	std::size_t size = std::min(_words->size(), other._words->size());
+	for (std::size_t i = 0; i < size; i++)
+		if ((_words->at(i) & other._words->at(i)) != 0) return true;
+	return false;
+}
+
+SymbolSet& SymbolSet::operator|=(const SymbolSet& other) {
+	if (includes(other)) return *this;
+	if (other.includes(*this)) {
+		_words = other._words;
+		return *this;
+	}
+	std::vector<std::uint64_t>* words = new std::vector<std::uint64_t>(std::max(_words->size(), other._words->size()), 0);
+	for (std::size_t i = 0; i < words->size(); i++) {
+		if (i < _words->size()) words->at(i) |= _words->at(i);
+		if (i < other._words->size()) words->at(i) |= other._words->at(i);
+	}
+	_words.reset(words);
+	return *this;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <unordered_map>
+
+
+namespace ast {
+
+
+	/**
+	 * @brief Dense id of an interned identifier.
+	 */
+	typedef std::size_t symbol_t;
+
+
+	/**
+	 * @brief Immutable bitset of symbols.
+	 * @details The bits are shared between sets: the union of a set and one of its subsets
+	 *          is the very same set. Hence, summaries of nested expressions hardly allocate.
+	 */
+	class SymbolSet {
+		private:
+			std::shared_ptr<const std::vector<std::uint64_t>> _words; // NULL iff. empty
+
+		public:
+			SymbolSet() {}
+			explicit SymbolSet(symbol_t symbol);
+			bool empty() const { return !_words; }
+			bool contains(symbol_t symbol) const;
+			bool includes(const SymbolSet& other) const;
+			bool intersects(const SymbolSet& other) const;
+			SymbolSet& operator|=(const SymbolSet& other);
+	};
+
+
+	/**
+	 * @brief Interns the identifiers of variables and functions.
+	 * @details Every distinct identifier is assigned a dense id once; ids are never released.
+	 *          The AST compares, hashes and looks up names by their ids. The text of an
+	 *          identifier is needed for printing and for the translation to Z3 only.
+	 */
+	class SymbolTable {
+		private:
+			std::unordered_map<std::string, symbol_t> _ids;
+			std::deque<std::string> _names; // references stay valid on growth
+			std::deque<SymbolSet> _singletons;
+
+		public:
+			/**
+			 * @brief The table used by all ASTs.
+			 */
+			static SymbolTable& instance();
+
+			symbol_t intern(const std::string& name);
+			const std::string& name(symbol_t symbol) const { return _names.at(symbol); }
+			/**
+			 * @brief The set containing just ```symbol```; it is shared by all its users.
+			 */
+			const SymbolSet& singleton(symbol_t symbol) const { return _singletons.at(symbol); }
+			std::size_t size() const { return _names.size(); }
+	};
+
+
+}
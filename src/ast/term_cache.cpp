@@ -0,0 +1,74 @@
+#include "ast/term_cache.hpp"
+#include "ast/ast.hpp"
+
+using namespace ast;
+
+
+TermCache* TermCache::_current = NULL;
+
+TermCache::TermCache(z3::context& context) : _context(context), _outer(_current) {
+	_current = this;
+}
+
+TermCache::~TermCache() {
+	assert(_current == this);
+	_current = _outer;
+}
+
+TermCache* TermCache::current(const z3::context& context) {
+	if (_current == NULL || &_current->_context != &context) return NULL;
+	return _current;
+}
+
+z3::expr TermCache::term(const std::shared_ptr<Expr>& expr) {
+	auto it = _terms.find(expr.get());
+	if (it != _terms.end()) {
+		_hits++;
+		return it->second.second;
+	}
+	z3::expr result = expr->z3(_context);
+	_terms.emplace(expr.get(), std::make_pair(expr, result));
+	return result;
+}
+
+z3::expr mk_const(z3::context& context, const VarDef& decl, const std::string& name) {
+	if (decl.type() == bool_t) return context.bool_const(name.c_str());
+	else if (decl.type() == int_t) return context.int_const(name.c_str());
+	else assert(false);
+}
+
+z3::expr TermCache::var(const VarDef& decl) {
+	auto it = _vars.find(&decl);
+	if (it != _vars.end()) {
+		_hits++;
+		return it->second;
+	}
+	return _vars.emplace(&decl, mk_const(_context, decl, decl.name())).first->second;
+}
+
+z3::expr TermCache::constant(const VarDef& decl, std::size_t num) {
+	auto key = std::make_pair(&decl, num);
+	auto it = _constants.find(key);
+	if (it != _constants.end()) {
+		_hits++;
+		return it->second;
+	}
+	auto prefix = decl.function() == NULL ? "global" : decl.function()->name();
+	auto name = prefix + "%" + decl.name() + "$" + std::to_string(num);
+	return _constants.emplace(key, mk_const(_context, decl, name)).first->second;
+}
+
+std::map<std::string, const VarDef*> TermCache::decls() const {
+	std::map<std::string, const VarDef*> result;
+	for (const auto& e : _vars)
+		result.emplace(e.second.decl().name().str(), e.first);
+	for (const auto& e : _constants)
+		result.emplace(e.second.decl().name().str(), e.first.first);
+	return result;
+}
+
+z3::expr ast::z3_term(const std::shared_ptr<Expr>& expr, z3::context& context) {
+	TermCache* cache = TermCache::current(context);
+	if (cache == NULL) return expr->z3(context);
+	return cache->term(expr);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <memory>
+#include <unordered_map>
+#include "z3++.h"
+
+
+namespace ast {
+
+	class Expr;
+	class VarDef;
+
+
+	/**
+	 * @brief Memoizes the Z3 terms of expressions and variables for one ```z3::context```.
+	 * @details While in scope, ```Expr::z3``` looks up the terms of subexpressions and the
+	 *          constants of variables here instead of building them again. Subexpressions are
+	 *          identified by address; the cache keeps them alive such that addresses cannot be reused.
+	 *          Variables are identified by their declaration, symbolic constants by declaration
+	 *          and index, hence no names are formatted or looked up once a term is known.
+	 *
+	 *          Caches nest; only the innermost one is used and only for its own context.
+	 *          A cache must be destroyed before its context.
+	 */
+	class TermCache {
+		private:
+			z3::context& _context;
+			TermCache* _outer;
+			std::unordered_map<const Expr*, std::pair<std::shared_ptr<Expr>, z3::expr>> _terms;
+			std::unordered_map<const VarDef*, z3::expr> _vars;
+			std::map<std::pair<const VarDef*, std::size_t>, z3::expr> _constants;
+			std::size_t _hits = 0;
+			static TermCache* _current;
+
+		public:
+			TermCache(z3::context& context);
+			~TermCache();
+			TermCache(const TermCache&) = delete;
+			TermCache& operator=(const TermCache&) = delete;
+
+			/**
+			 * @brief The innermost cache if it belongs to ```context```; ```NULL``` otherwise.
+			 */
+			static TermCache* current(const z3::context& context);
+
+			z3::expr term(const std::shared_ptr<Expr>& expr);
+			z3::expr var(const VarDef& decl);
+			z3::expr constant(const VarDef& decl, std::size_t num);
+
+			/**
+			 * @brief The declarations of the variables and symbolic constants converted so far, by the names of their constants.
+			 */
+			std::map<std::string, const VarDef*> decls() const;
+
+			/**
+			 * @brief Drops (and releases) the terms of subexpressions; those of variables and symbolic constants are kept.
+			 */
+			void forget_terms() { _terms.clear(); }
+
+			std::size_t size() const { return _terms.size() + _vars.size() + _constants.size(); }
+			std::size_t hits() const { return _hits; }
+	};
+
+
+	/**
+	 * @brief Converts a subexpression using the current ```TermCache``` of ```context```, if any.
+	 */
+	z3::expr z3_term(const std::shared_ptr<Expr>& expr, z3::context& context);
+
+}
@@ -0,0 +1,68 @@
+#include "ast/versions.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace ast;
+
+
+// chains of layers are flattened beyond this depth such that lookups remain cheap
+#define MAX_LAYER_DEPTH 16
+
+
+VersionMap::map_t& VersionMap::modify() {
+	if (_layer.use_count() > 1) {
+		// shared with a copy (or a layer on top of it); continue on a layer of our own
+		std::shared_ptr<Layer> layer(new Layer());
+		if (_layer->depth < MAX_LAYER_DEPTH) {
+			layer->parent = _layer;
+			layer->depth = _layer->depth + 1;
+		} else {
+			layer->versions = entries();
+		}
+		_layer = layer;
+	}
+	return _layer->versions;
+}
+
+const std::size_t* VersionMap::find(const VarDef* var) const {
+	for (const Layer* layer = _layer.get(); layer != NULL; layer = layer->parent.get()) {
+		auto it = layer->versions.find(var);
+		if (it != layer->versions.end()) return &it->second;
+	}
+	return NULL;
+}
+
+std::size_t VersionMap::at(const VarDef* var) const {
+	const std::size_t* version = find(var);
+	if (version == NULL) throw std::out_of_range("Variable has no version.");
+	return *version;
+}
+
+void VersionMap::set(const VarDef* var, std::size_t version) {
+	modify()[var] = version;
+	std::size_t& highest = (*_highest)[var];
+	highest = std::max(highest, version);
+}
+
+std::size_t VersionMap::next(const VarDef* var) {
+	const std::size_t* current = find(var);
+	std::size_t version = (current != NULL ? *current : 0) + 1;
+	set(var, version);
+	return version;
+}
+
+VersionMap::map_t VersionMap::entries() const {
+	// upper layers take precedence
+	map_t result;
+	for (const Layer* layer = _layer.get(); layer != NULL; layer = layer->parent.get())
+		result.insert(layer->versions.begin(), layer->versions.end());
+	return result;
+}
+
+std::vector<std::pair<const VarDef*, std::size_t>> VersionMap::changes(const VersionMap& base) const {
+	map_t seen;
+	for (const Layer* layer = _layer.get(); layer != NULL && layer != base._layer.get(); layer = layer->parent.get())
+		seen.insert(layer->versions.begin(), layer->versions.end());
+	return std::vector<std::pair<const VarDef*, std::size_t>>(seen.begin(), seen.end());
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <vector>
+
+
+namespace ast {
+
+	class VarDef;
+
+
+	/**
+	 * @brief Current SSA versions of variables, i.e. the indices of their ```SymbolicConstant``` s.
+	 * @details A map consists of layers of versions, each one assigned on top of its parent layer.
+	 *          Copies share their layers; once shared, a layer is never modified again, instead a
+	 *          modified copy continues on a fresh layer of its own. Hence, saving the map at calls
+	 *          or branches is cheap and a modification only costs the entries it writes.
+	 *          In addition, all copies share the highest version ever assigned to each variable.
+	 *
+	 * @see TraceableStatement::con
+	 */
+	class VersionMap {
+		public:
+			typedef std::map<const VarDef*, std::size_t> map_t;
+
+		private:
+			struct Layer {
+				std::shared_ptr<const Layer> parent;
+				map_t versions;
+				std::size_t depth = 0;
+			};
+
+			std::shared_ptr<Layer> _layer;
+			std::shared_ptr<map_t> _highest;
+
+			map_t& modify();
+
+		public:
+			VersionMap() : _layer(new Layer()), _highest(new map_t()) {}
+			/**
+			 * @brief The current version of ```var```; ```NULL``` if it has none.
+			 */
+			const std::size_t* find(const VarDef* var) const;
+			std::size_t count(const VarDef* var) const { return find(var) != NULL ? 1 : 0; }
+			std::size_t at(const VarDef* var) const;
+			void set(const VarDef* var, std::size_t version);
+			/**
+			 * @brief Increments the version of ```var``` (which is 0 if there is none).
+			 * @return the new version
+			 */
+			std::size_t next(const VarDef* var);
+			/**
+			 * @brief The highest version assigned to each variable by this map or one of its copies.
+			 */
+			const map_t& highest() const { return *_highest; }
+			/**
+			 * @brief All current versions; takes time linear in the number of variables.
+			 */
+			map_t entries() const;
+			/**
+			 * @brief The versions assigned since this map was copied from ```base``` (and ```base``` was left unmodified);
+			 *        all versions otherwise.
+			 */
+			std::vector<std::pair<const VarDef*, std::size_t>> changes(const VersionMap& base) const;
+	};
+
+
+}
@@ -0,0 +1,102 @@
+#include "cegar/bmc.hpp"
+
+#include <iostream>
+#include "ast/ast.hpp"
+#include "cegar/cegar.hpp"
+
+using namespace cegar;
+
+
+/******************************************************************************
+	Helpers
+ ******************************************************************************/
+
+z3::expr disjunction(z3::context& context, const std::vector<z3::expr>& exprs) {
+	z3::expr result = context.bool_val(false);
+	for (const auto& e : exprs) result = result || e;
+	return result;
+}
+
+z3::check_result check_depth(z3::solver& solver, std::string name, std::size_t depth, const z3::expr& goal, const ast::Unrolling& unrolling) {
+	// goal is only enabled for this query; the constraints it depends on stay in the solver
+	z3::context& context = solver.ctx();
+	z3::expr act = context.bool_const(("bmc$" + name + "$" + std::to_string(depth)).c_str());
+	solver.add(z3::implies(act, goal));
+	z3::expr_vector assumptions(context);
+	assumptions.push_back(act);
+	// executions must not pass holes that are not unrolled yet
+	for (const auto& r : unrolling.resumptions()) assumptions.push_back(!r);
+	return solver.check(assumptions);
+}
+
+
+/******************************************************************************
+	Bounded Model Checking
+ ******************************************************************************/
+
+bool cegar::prove_bmc(std::string filename, const Options& options) {
+	auto clk_begin = clock();
+
+	std::unique_ptr<ast::Program> program(load_program(filename));
+	program->prettyprint(std::cout);
+	const ast::FunDef* main = program->name2fun().at("main");
+
+	z3::context context;
+	z3::solver solver(context);
+	ast::Unrolling::lvalmap_t top;
+	ast::Unrolling unrolling(context, 0, top);
+	std::size_t added = 0;
+
+	for (std::size_t depth = 0; depth <= options.bound; depth++) {
+		/*output*/std::cout << "Unrolling with depth " << depth << "..." << std::endl;
+		if (depth == 0) main->unroll(unrolling);
+		else unrolling.extend();
+		// the constraints of the previous depths are still in the solver
+		for (; added < unrolling.constraints().size(); added++)
+			solver.add(unrolling.constraints()[added]);
+
+		std::vector<z3::expr> violations;
+		for (const auto& v : unrolling.violations()) violations.push_back(v.second);
+		auto res = check_depth(solver, "violation", depth, disjunction(context, violations), unrolling);
+
+		if (res == z3::sat) {
+			z3::model model = solver.get_model();
+			/*output*/std::cout << std::endl << "Violated assertion(s) at depth " << depth << ":" << std::endl;
+			for (const auto& v : unrolling.violations())
+				if (Z3_get_bool_value(context, model.eval(v.second, true)) == Z3_L_TRUE)
+					/*output*/v.first->prettyprint(std::cout, 1);
+
+			/*output*/std::cout << std::endl;
+			/*output*/std::cout << "   +-------------------------+" << std::endl;
+			/*output*/std::cout << "   | Your programm is WRONG! |" << std::endl;
+			/*output*/std::cout << "   +-------------------------+" << std::endl;
+			/*output*/std::cout << std::endl;
+			/*output*/std::cout << "Total Time Taken: " << (clock()-clk_begin)/1000/1000.0 << "s" << std::endl;
+			return false;
+		}
+		if (res == z3::unknown) {
+			/*output*/std::cout << "Solver returned 'unknown' at depth " << depth << "; continuing." << std::endl;
+			continue;
+		}
+
+		// no assertion violated; done if no execution is cut off by the bound
+		if (check_depth(solver, "cutoff", depth, disjunction(context, unrolling.cutoffs()), unrolling) == z3::unsat) {
+			/*output*/std::cout << std::endl;
+			/*output*/std::cout << "   +---------------------------+" << std::endl;
+			/*output*/std::cout << "   | Your programm is CORRECT! |" << std::endl;
+			/*output*/std::cout << "   +---------------------------+" << std::endl;
+			/*output*/std::cout << std::endl;
+			/*output*/std::cout << "Total Time Taken: " << (clock()-clk_begin)/1000/1000.0 << "s" << std::endl;
+			return true;
+		}
+	}
+
+	/*output*/std::cout << std::endl;
+	/*output*/std::cout << "   +--------------------------------+" << std::endl;
+	/*output*/std::cout << "   | No violation within the bound! |" << std::endl;
+	/*output*/std::cout << "   +--------------------------------+" << std::endl;
+	/*output*/std::cout << std::endl;
+	/*output*/std::cout << "Bound: " << options.bound << std::endl;
+	/*output*/std::cout << "Total Time Taken: " << (clock()-clk_begin)/1000/1000.0 << "s" << std::endl;
+	throw Inconclusive("No violation within the bound.");
+}
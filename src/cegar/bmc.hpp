@@ -0,0 +1,34 @@
+#pragma once
+
+#include <string>
+#include "ast/ast.hpp"
+#include "cegar/options.hpp"
+
+
+namespace cegar {
+
+
+	/**
+	 * @brief Searches a C-like integer program for assertion errors
+	 *        using SMT-based bounded model checking.
+	 * @details The program is unrolled for increasing bounds ```k = 0, 1, ..., bound```,
+	 *          i.e. loops are unwound ```k``` times and recursive calls are inlined up
+	 *          to a recursion depth of ```k```. A single unrolling is kept in an
+	 *          incremental solver and extended by one step at each point where the
+	 *          previous bound cut it off; executions passing such a point are excluded
+	 *          by assumptions until it is unrolled. Assertion violations of the current
+	 *          depth are checked under an activation literal.
+	 *          If no execution exceeds the current bound and no assertion is violated,
+	 *          the program is proven correct.
+	 *
+	 * @see ast::Unrolling
+	 * @param filename path to a file containing the program to check
+	 * @param options maximal unwinding depth
+	 * @return ```true``` if the program is proven correct,
+	 *         ```false``` if the program is proven incorrect.
+	 * @throws Inconclusive if no violation exists within the bound
+	 */
+	bool prove_bmc(std::string filename, const Options& options=Options());
+
+
+}
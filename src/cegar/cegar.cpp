@@ -1,14 +1,19 @@
 #include "cegar/cegar.hpp"
 
 #include <iostream>
-#include <boost/range/adaptor/reversed.hpp>
+#include <fstream>
+#include <chrono>
 #include "ast/ast.hpp"
 #include "ast/trace.hpp"
 #include "parser/parser.hpp"
 #include "ast/abstraction_utils.hpp"
+#include "ast/query_log.hpp"
+#include "ast/term_cache.hpp"
 #include "symbolic/Reachability.hpp"
 #include "cegar/constraints.hpp"
 #include "cegar/interpolate.hpp"
+#include "cegar/certificate.hpp"
+#include "cegar/slicing.hpp"
 #include <sys/time.h>
 
 using namespace cegar;
@@ -23,7 +28,7 @@ using namespace cegar;
 	Helpers
  ******************************************************************************/
 
-ast::Program* load_program(const std::string filename) {
+ast::Program* cegar::load_program(std::string filename) {
 	auto progstream = parser::open_file(filename);
 	ast::Program* prog = parser::parse_program(progstream);
 	prog->add_initializers();
@@ -32,19 +37,43 @@ ast::Program* load_program(const std::string filename) {
 }
 
 
-bool is_spurious(ast::Program& prog, const std::vector<const ast::TraceableStatement*>& trace) {
-	auto wp = std::unique_ptr<ast::Expr>(new ast::Literal(false));
-	for (auto stmt : boost::adaptors::reverse(trace))
-		wp.reset(stmt->wp(*wp));
+bool is_spurious(z3::solver& solver, const std::vector<const ast::TraceableStatement*>& trace) {
+	// the trace is spurious iff. its SSA constraints are unsatisfiable
+	z3::context& context = solver.ctx();
+	std::vector<ast::Expr*> constraints = compute_constraints(trace);
+	ast::QueryOrigin origin("spurious check");
+
+	// the conjunction is only needed for the query log
+	bool logged = ast::QueryLog::instance().enabled();
+	solver.push();
+	z3::expr conj = context.bool_val(true);
+	for (std::size_t i = 0; i < constraints.size(); i++) {
+		z3::expr con = constraints.at(i)->z3(context);
+		solver.add(con);
+		if (logged) conj = conj && con;
+		delete constraints.at(i);
+	}
 
-	z3::context context;
-	z3::solver solver(context);
+	auto clk_begin = std::chrono::steady_clock::now();
+	auto res = solver.check();
+	if (logged) {
+		std::string status = res == z3::sat ? "sat" : (res == z3::unsat ? "unsat" : "unknown");
+		ast::QueryLog::instance().record(conj, status, std::chrono::duration<double>(std::chrono::steady_clock::now() - clk_begin).count());
+	}
+	solver.pop();
+
+	// the constraints are specific to this trace; only the terms of symbolic constants are worth keeping
+	ast::TermCache* terms = ast::TermCache::current(context);
+	if (terms != NULL) terms->forget_terms();
 
-	return ast::is_taut(solver, wp->z3(context));
+	// a trace whose feasibility is unknown must not be reported as a counterexample
+	if (res == z3::unknown)
+		throw Inconclusive("Feasibility of a counterexample is unknown.");
+	return res == z3::unsat;
 }
 
 
-void refine_predicates(ast::PredicateList& preds, const ast::Program& prog, const std::vector<const ast::TraceableStatement*>& trace) {
+void refine_predicates(ast::PredicateList& preds, const ast::Program& prog, const std::vector<const ast::TraceableStatement*>& trace, bool whole_interpolants) {
 	std::vector<ast::Expr*> constraints = compute_constraints(trace);
 	assert(constraints.size() == trace.size());
 
@@ -65,6 +94,12 @@ void refine_predicates(ast::PredicateList& preds, const ast::Program& prog, cons
 	for (ast::Expr* e : interpolants) {
 		ast::Expr* post = e->postprocess_interpolant(prog);
 		delete e;
+		// interpolants may mix up scopes; those are split into atoms anyway
+		bool trivial = dynamic_cast<ast::Literal*>(post) != NULL && dynamic_cast<ast::VarName*>(post) == NULL;
+		if (whole_interpolants && !trivial && post->is_well_scoped()) {
+			newones.push_back(post);
+			continue;
+		}
 		post->collect_potential_predicates(newones);
 		delete post;
 	}
@@ -93,7 +128,7 @@ void refine_predicates(ast::PredicateList& preds, const ast::Program& prog, cons
 	CEGAR Loop
  ******************************************************************************/
 
-bool cegar::prove(std::string filename) {
+bool cegar::prove(std::string filename, const Options& options) {
 	auto clk_begin = clock();
 
 	std::unique_ptr<ast::Program> program, abstract;
@@ -103,8 +138,29 @@ bool cegar::prove(std::string filename) {
 	program.reset(load_program(filename));
 	predicates.reset(new ast::PredicateList({}));
 
+	// inlining small functions saves their procedures and call edges in the CFG; whatever cannot
+	// influence an assertion costs BDD variables and abstraction queries only; certificates,
+	// however, are checked against the program as written
+	if (options.certificate.empty()) {
+		if (options.inline_threshold > 0) {
+			std::size_t inlined = program->inline_calls(options.inline_threshold);
+			/*output*/std::cout << "Inlined calls: " << inlined << std::endl;
+		}
+		std::size_t removed = program->slice();
+		/*output*/std::cout << "Sliced program: " << removed << " statements removed." << std::endl;
+		/*output*/std::cout << "Procedures excluded from abstraction:";
+		for (const ast::FunDef* f : program->exclude_procedures())
+			/*output*/std::cout << " " << f->name() << "()";
+		/*output*/std::cout << std::endl;
+	}
+
 	program->prettyprint(std::cout);
 
+	// spuriousness checks share a solver and the terms of symbolic constants (cf. is_spurious)
+	z3::context context;
+	z3::solver solver(context);
+	ast::TermCache terms(context);
+
 	// CEGAR loop
 	std::size_t loop_count = 1;
 	while (true) {
@@ -114,7 +170,8 @@ bool cegar::prove(std::string filename) {
 
 		// STEP 1: abstract
 		abstract.reset(program->abstract(*predicates));
-		cfg.reset(abstract->cfg());
+		cfg.reset(abstract->cfg(options.large_blocks && options.certificate.empty()));
+		if (options.reorder) cfg->enableReordering();
 
 		/*output*/predicates->prettyprint(std::cout);
 		/*output*/std::cout << std::endl;
@@ -124,20 +181,35 @@ bool cegar::prove(std::string filename) {
 		// STEP 2: reachability analysis; search for counterexample
 		BDD init = cfg->encode(INIT);
 		BDD bad = cfg->encode(FAIL);
-		BDD reachset = symbolic::reachable(*cfg, init, bad);
+		BDD relation;
+		BDD reachset = symbolic::reachable(*cfg, init, bad, false, options.frontier, &relation);
 		if ((reachset & bad) == cfg->zero()) {
 			/*output*/std::cout << std::endl;
 			/*output*/std::cout << "   +---------------------------+" << std::endl;
 			/*output*/std::cout << "   | Your programm is CORRECT! |" << std::endl;
 			/*output*/std::cout << "   +---------------------------+" << std::endl;
 			/*output*/std::cout << std::endl;
+			if (!options.certificate.empty()) {
+				std::ofstream out(options.certificate);
+				write_certificate(out, extract_certificate(*program, *abstract, *predicates, *cfg, relation));
+				/*output*/std::cout << "Certificate written to '" << options.certificate << "'." << std::endl;
+			}
 			/*output*/std::cout << "Total Time Taken: " << (clock()-clk_begin)/1000/1000.0 << "s" << std::endl;
 			return true; // if no bad state is reachable, we are done
 		}
 
 		// STEP 3: check if counterexample is spurious
+		// only the cone of influence of the violated assertion is checked and refined;
+		// if the slice is feasible, the whole trace decides
 		auto trace = ast::flat_trace(*abstract, *cfg, init, bad, reachset);
-		if (!is_spurious(*program, trace)) {
+		auto sliced = slice_trace(trace);
+		/*output*/std::cout << "Sliced counterexample: " << sliced.size() << " of " << trace.size() << " statements." << std::endl;
+		bool spurious = is_spurious(solver, sliced);
+		if (!spurious && sliced.size() < trace.size()) {
+			spurious = is_spurious(solver, trace);
+			sliced = trace;
+		}
+		if (!spurious) {
 			/*output*/std::cout << std::endl;
 			/*output*/std::cout << "   +-------------------------+" << std::endl;
 			/*output*/std::cout << "   | Your programm is WRONG! |" << std::endl;
@@ -148,9 +220,9 @@ bool cegar::prove(std::string filename) {
 		}
 
 		// STEP 4: refine abstraction
-		trace.pop_back(); // no need to delete pointer -> owned by abstract program
+		sliced.pop_back(); // no need to delete pointer -> owned by abstract program
 		auto num_preds = predicates->size();
-		refine_predicates(*predicates, *program, trace);
+		refine_predicates(*predicates, *program, sliced, options.interpolant_predicates);
 		if (predicates->size() == num_preds) {
 			/*output*/std::cout << std::endl;
 			/*output*/std::cout << "   +----------------------+" << std::endl;
@@ -158,7 +230,7 @@ bool cegar::prove(std::string filename) {
 			/*output*/std::cout << "   +----------------------+" << std::endl;
 			/*output*/std::cout << std::endl;
 			/*output*/std::cout << "Total Time Taken: " << (clock()-clk_begin)/1000/1000.0 << "s" << std::endl;
-			assert(false);
+			throw Inconclusive("Refinement did not make any progress.");
 		}
 
 		loop_count++;
@@ -169,5 +241,5 @@ bool cegar::prove(std::string filename) {
 	abstract.reset();
 	predicates.reset();
 	program.reset();
-	assert(false);
+	throw Inconclusive("Maximal number of iterations reached.");
 }
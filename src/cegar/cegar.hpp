@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include "parser/parser.hpp" // TODO: why do we need to include this here?? -> runtime error if removed...
+#include "cegar/options.hpp"
 
 
 /**
@@ -10,6 +11,17 @@
 namespace cegar {
 
 
+	/**
+	 * @brief Reads a program from a file and prepares it for verification.
+	 * @details Adds variable initializers and validates the program.
+	 * @see ast::Program::add_initializers
+	 * @see ast::Program::validate
+	 * @param filename path to a file containing the program
+	 * @return the validated program; ownership should be claimed
+	 */
+	ast::Program* load_program(std::string filename);
+
+
 	/**
 	 * @brief Performs a CEGAR loop to check C-like integer
 	 *        program for assertions errors.
@@ -35,10 +47,13 @@ namespace cegar {
 	 * @see ast::extract_trace
 	 * @see ast::hoare_proof
 	 * @param filename path to a file containing the program to check
+	 * @param options configuration of the BDD backend and the refinement
 	 * @return ```true``` if the program is proven correct,
 	 *         ```false``` if the program is proven incorrect.
+	 * @throws Inconclusive if the refinement does not make progress or
+	 *         the feasibility of a counterexample cannot be decided
 	 */
-	bool prove(std::string filename);
+	bool prove(std::string filename, const Options& options=Options());
 
 
 }
\ No newline at end of file
@@ -0,0 +1,442 @@
+#include "cegar/certificate.hpp"
+
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include "ast/ast.hpp"
+#include "cegar/cegar.hpp"
+
+using namespace cegar;
+
+
+#define ENTRY 0 // index of the value of a global variable on entry of a function
+#define CURRENT 1 // index of the current value of a variable
+#define NEXT 2 // index of the value of a variable after a statement
+#define CALLEE 3 // index of the locals of a called function
+
+typedef std::pair<const ast::FunDef*, std::size_t> Location;
+
+
+/******************************************************************************
+	Helpers
+ ******************************************************************************/
+
+std::vector<const ast::VarDef*> visible_vars(const ast::Program& program, const ast::FunDef* fun) {
+	std::vector<const ast::VarDef*> result;
+	for (const auto& e : program.name2var())
+		result.push_back(e.second);
+	if (fun != NULL)
+		for (const auto& e : fun->name2var())
+			result.push_back(e.second);
+	return result;
+}
+
+z3::expr constant(z3::context& context, const ast::VarDef* var, std::size_t index) {
+	return ast::SymbolicConstant(var, index).z3(context);
+}
+
+z3::expr rename(z3::context& context, const ast::Expr& expr, const std::vector<const ast::VarDef*>& vars, std::size_t index) {
+	ast::VersionMap lvalmap;
+	for (const ast::VarDef* v : vars) lvalmap.set(v, index);
+	ast::Assume tmp(expr.copy());
+	std::unique_ptr<ast::Expr> con(tmp.con(lvalmap));
+	return con->z3(context);
+}
+
+z3::expr substitute(z3::expr expr, const std::vector<std::pair<z3::expr, z3::expr>>& repl) {
+	if (repl.empty()) return expr;
+	z3::expr_vector src(expr.ctx()), dst(expr.ctx());
+	for (const auto& e : repl) {
+		src.push_back(e.first);
+		dst.push_back(e.second);
+	}
+	return expr.substitute(src, dst);
+}
+
+void print(std::ostream& os, const z3::expr& expr) {
+	// plain SMT-LIB without let bindings, cf. parse
+	if (expr.is_numeral()) {
+		std::string num = Z3_get_numeral_string(expr.ctx(), expr);
+		if (num[0] == '-') os << "(- " << num.substr(1) << ")";
+		else os << num;
+	} else if (expr.is_const()) {
+		os << expr.decl().name().str();
+	} else {
+		os << "(" << expr.decl().name().str();
+		for (unsigned int i = 0; i < expr.num_args(); i++) {
+			os << " ";
+			print(os, expr.arg(i));
+		}
+		os << ")";
+	}
+}
+
+std::string print(const z3::expr& expr) {
+	std::stringstream result;
+	print(result, expr);
+	return result.str();
+}
+
+
+/******************************************************************************
+	Parsing
+ ******************************************************************************/
+
+class TermParser {
+	// parses the SMT-LIB terms produced by print
+	private:
+		z3::context& _context;
+		const std::map<std::string, z3::expr>& _symbols;
+		std::vector<std::string> _tokens;
+		std::size_t _pos = 0;
+
+		z3::expr term();
+		std::string next();
+
+	public:
+		TermParser(z3::context& context, const std::map<std::string, z3::expr>& symbols) : _context(context), _symbols(symbols) {}
+		z3::expr parse(const std::string& str);
+};
+
+std::string TermParser::next() {
+	if (_pos >= _tokens.size()) throw ast::ValidationError("Unexpected end of certificate term.");
+	return _tokens.at(_pos++);
+}
+
+z3::expr TermParser::parse(const std::string& str) {
+	_tokens.clear();
+	_pos = 0;
+	std::string token;
+	for (char c : str) {
+		if (c == '(' || c == ')' || std::isspace(c)) {
+			if (token != "") _tokens.push_back(token);
+			if (c == '(' || c == ')') _tokens.push_back(std::string(1, c));
+			token = "";
+		} else {
+			token += c;
+		}
+	}
+	if (token != "") _tokens.push_back(token);
+
+	z3::expr result = term();
+	if (_pos != _tokens.size()) throw ast::ValidationError("Trailing input after certificate term '" + str + "'.");
+	return result;
+}
+
+z3::expr TermParser::term() {
+	std::string token = next();
+	if (token == ")") throw ast::ValidationError("Unexpected ')' in certificate term.");
+	if (token != "(") {
+		if (token == "true") return _context.bool_val(true);
+		if (token == "false") return _context.bool_val(false);
+		if (std::isdigit(token[0])) return _context.int_val(token.c_str());
+		if (_symbols.count(token) == 0) throw ast::ValidationError("Unknown symbol '" + token + "' in certificate term.");
+		return _symbols.at(token);
+	}
+
+	std::string op = next();
+	std::vector<z3::expr> args;
+	while (_pos < _tokens.size() && _tokens.at(_pos) != ")")
+		args.push_back(term());
+	next();
+
+	if (args.empty()) throw ast::ValidationError("Operator '" + op + "' without arguments in certificate term.");
+	if (op == "not" && args.size() == 1) return !args.at(0);
+	if (op == "-" && args.size() == 1) return -args.at(0);
+	if (op == "ite" && args.size() == 3) return z3::to_expr(_context, Z3_mk_ite(_context, args.at(0), args.at(1), args.at(2)));
+	if (op == "=>" && args.size() == 2) return z3::implies(args.at(0), args.at(1));
+	if (op == "=" && args.size() == 2) return args.at(0) == args.at(1);
+	if (op == "distinct" && args.size() == 2) return args.at(0) != args.at(1);
+	if (op == "<" && args.size() == 2) return args.at(0) < args.at(1);
+	if (op == "<=" && args.size() == 2) return args.at(0) <= args.at(1);
+	if (op == ">" && args.size() == 2) return args.at(0) > args.at(1);
+	if (op == ">=" && args.size() == 2) return args.at(0) >= args.at(1);
+	if (op == "div" && args.size() == 2) return args.at(0) / args.at(1);
+
+	z3::expr result = args.at(0);
+	for (std::size_t i = 1; i < args.size(); i++) {
+		if (op == "and") result = result && args.at(i);
+		else if (op == "or") result = result || args.at(i);
+		else if (op == "+") result = result + args.at(i);
+		else if (op == "-") result = result - args.at(i);
+		else if (op == "*") result = result * args.at(i);
+		else throw ast::ValidationError("Unsupported operator '" + op + "' in certificate term.");
+	}
+	return result;
+}
+
+
+/******************************************************************************
+	Extraction
+ ******************************************************************************/
+
+z3::expr join(z3::context& context, const std::vector<z3::expr>& exprs, bool conjunction) {
+	if (exprs.empty()) return context.bool_val(conjunction);
+	z3::expr result = exprs.at(0);
+	for (std::size_t i = 1; i < exprs.size(); i++)
+		result = conjunction ? result && exprs.at(i) : result || exprs.at(i);
+	return result;
+}
+
+z3::expr cubes2expr(z3::context& context, const symbolic::ControlFlowGraph& cfg, BDD bdd, const std::map<unsigned int, z3::expr>& literals) {
+	// only the given BDD variables are of interest
+	BDD irrelevant = cfg.one();
+	for (const BDD& v : cfg.variables())
+		if (literals.count(v.NodeReadIndex()) == 0)
+			irrelevant *= v;
+	bdd = bdd.ExistAbstract(irrelevant);
+
+	std::vector<z3::expr> disjuncts;
+	DdGen* gen;
+	int* cube;
+	Cudd_ForeachPrime(bdd.manager(), bdd.getNode(), bdd.getNode(), gen, cube) {
+		std::vector<z3::expr> conjuncts;
+		for (const auto& lit : literals) {
+			if (cube[lit.first] == 0) conjuncts.push_back(!lit.second);
+			else if (cube[lit.first] == 1) conjuncts.push_back(lit.second);
+		}
+		disjuncts.push_back(join(context, conjuncts, true));
+	}
+	return join(context, disjuncts, false);
+}
+
+Certificate cegar::extract_certificate(const ast::Program& program, const ast::Program& abstract, const ast::PredicateList& predicates, const symbolic::ControlFlowGraph& cfg, const BDD relation) {
+	z3::context context;
+	Certificate certificate;
+
+	// predicates per BDD variable; global ones also on entry of a function
+	std::map<unsigned int, z3::expr> globals;
+	auto lookup = [&] (std::string scope, std::string varname) -> const ast::Predicate* {
+		for (const ast::Predicate* p : predicates.preds_for(scope))
+			if (p->varname() == varname) return p;
+		assert(false);
+	};
+	std::vector<const ast::VarDef*> global_vars = visible_vars(program, NULL);
+	for (const auto& e : abstract.name2var()) {
+		const ast::Expr& pred = *lookup("global", e.first)->expr();
+		globals.emplace(cfg.programVariables().at(e.second->cfgid()).NodeReadIndex(), rename(context, pred, global_vars, CURRENT));
+		globals.emplace(cfg.globalVariablesRel().at(e.second->cfgid()).NodeReadIndex(), rename(context, pred, global_vars, ENTRY));
+	}
+
+	auto abstract_funs = abstract.name2fun();
+	for (const auto& f : program.name2fun()) {
+		const ast::FunDef* fun = f.second;
+		const ast::FunDef* absfun = abstract_funs.at(f.first);
+		std::unique_ptr<ast::Locator> locator(fun->locate(*absfun));
+
+		std::map<unsigned int, z3::expr> literals = globals;
+		std::vector<const ast::VarDef*> vars = visible_vars(program, fun);
+		for (const auto& e : absfun->name2var()) {
+			const ast::Expr& pred = *lookup(f.first, e.first)->expr();
+			literals.emplace(cfg.programVariables().at(e.second->cfgid()).NodeReadIndex(), rename(context, pred, vars, CURRENT));
+		}
+
+		for (std::size_t loc = 0; loc < locator->size(); loc++) {
+			BDD reach = relation * cfg.encode(locator->node(loc));
+			if (reach == cfg.zero()) continue;
+			certificate.invariants[std::make_pair(f.first, loc)] = print(cubes2expr(context, cfg, reach, literals));
+		}
+
+		// the locals of the function do not matter on exit
+		BDD exit = relation * cfg.encode(absfun->cfg_procedure()->exit());
+		if (exit == cfg.zero()) continue;
+		certificate.summaries[f.first] = print(cubes2expr(context, cfg, exit, globals));
+	}
+
+	return certificate;
+}
+
+
+/******************************************************************************
+	Reading and Writing
+ ******************************************************************************/
+
+void cegar::write_certificate(std::ostream& os, const Certificate& certificate) {
+	for (const auto& e : certificate.invariants)
+		os << "invariant " << e.first.first << " " << e.first.second << " " << e.second << std::endl;
+	for (const auto& e : certificate.summaries)
+		os << "summary " << e.first << " " << e.second << std::endl;
+}
+
+Certificate cegar::read_certificate(std::istream& is) {
+	Certificate certificate;
+	std::string line;
+	while (std::getline(is, line)) {
+		std::stringstream ls(line);
+		std::string kind, fun, term;
+		std::size_t loc;
+		ls >> kind;
+		if (kind == "") continue;
+		else if (kind == "invariant" && ls >> fun >> loc && std::getline(ls, term)) certificate.invariants[std::make_pair(fun, loc)] = term;
+		else if (kind == "summary" && ls >> fun && std::getline(ls, term)) certificate.summaries[fun] = term;
+		else throw ast::ValidationError("Malformed certificate line '" + line + "'.");
+	}
+	return certificate;
+}
+
+
+/******************************************************************************
+	Checking
+ ******************************************************************************/
+
+class CertificateChecker {
+	private:
+		const ast::Program& _program;
+		z3::context _context;
+		z3::solver _solver;
+		std::map<std::string, z3::expr> _symbols;
+		std::map<const ast::FunDef*, std::unique_ptr<ast::FlowGraph>> _flow;
+		std::map<Location, z3::expr> _invariants;
+		std::map<const ast::FunDef*, z3::expr> _summaries;
+		std::size_t _obligations = 0;
+		std::size_t _failures = 0;
+
+		z3::expr invariant(const ast::FunDef* fun, std::size_t loc);
+		z3::expr summary(const ast::FunDef* fun);
+		void discharge(const z3::expr& formula, const ast::FunDef* fun, std::string what);
+		void check_edge(const ast::FunDef* fun, const ast::FlowGraph::Edge& edge);
+		void check_call(const ast::FunDef* fun, const ast::FlowGraph::Edge& edge, const ast::FunDef* callee);
+
+	public:
+		CertificateChecker(const ast::Program& program, const Certificate& certificate);
+		bool check();
+		std::size_t obligations() const { return _obligations; }
+		std::size_t failures() const { return _failures; }
+};
+
+CertificateChecker::CertificateChecker(const ast::Program& program, const Certificate& certificate) : _program(program), _solver(_context) {
+	for (const ast::VarDef* v : visible_vars(program, NULL)) {
+		z3::expr entry = constant(_context, v, ENTRY);
+		_symbols.emplace(entry.decl().name().str(), entry);
+	}
+	for (const auto& f : program.name2fun()) {
+		for (const ast::VarDef* v : visible_vars(program, f.second)) {
+			z3::expr current = constant(_context, v, CURRENT);
+			_symbols.emplace(current.decl().name().str(), current);
+		}
+		_flow[f.second].reset(f.second->flow());
+	}
+
+	TermParser parser(_context, _symbols);
+	for (const auto& e : certificate.invariants) {
+		if (program.name2fun().count(e.first.first) == 0) throw ast::ValidationError("Certificate refers to unknown function '" + e.first.first + "'.");
+		const ast::FunDef* fun = program.name2fun().at(e.first.first);
+		_invariants.emplace(std::make_pair(fun, e.first.second), parser.parse(e.second));
+	}
+	for (const auto& e : certificate.summaries) {
+		if (program.name2fun().count(e.first) == 0) throw ast::ValidationError("Certificate refers to unknown function '" + e.first + "'.");
+		_summaries.emplace(program.name2fun().at(e.first), parser.parse(e.second));
+	}
+}
+
+z3::expr CertificateChecker::invariant(const ast::FunDef* fun, std::size_t loc) {
+	auto it = _invariants.find(std::make_pair(fun, loc));
+	if (it == _invariants.end() || loc == _flow.at(fun)->error()) return _context.bool_val(false);
+	return it->second;
+}
+
+z3::expr CertificateChecker::summary(const ast::FunDef* fun) {
+	auto it = _summaries.find(fun);
+	if (it == _summaries.end()) return _context.bool_val(false);
+	return it->second;
+}
+
+void CertificateChecker::discharge(const z3::expr& formula, const ast::FunDef* fun, std::string what) {
+	// obligations hold iff. their negation (formula) is unsatisfiable
+	_obligations++;
+	_solver.push();
+	_solver.add(formula);
+	bool valid = _solver.check() == z3::unsat;
+	_solver.pop();
+	if (valid) return;
+
+	_failures++;
+	/*output*/std::cout << "-- obligation violated in '" << fun->name() << "': " << what << std::endl;
+}
+
+void CertificateChecker::check_edge(const ast::FunDef* fun, const ast::FlowGraph::Edge& edge) {
+	std::vector<const ast::VarDef*> vars = visible_vars(_program, fun);
+	ast::VersionMap lvalmap;
+	for (const ast::VarDef* v : vars) lvalmap.set(v, CURRENT);
+	std::unique_ptr<ast::Expr> con(edge.stmt->con(lvalmap));
+
+	std::vector<std::pair<z3::expr, z3::expr>> post;
+	for (const ast::VarDef* v : vars)
+		if (lvalmap.at(v) != CURRENT)
+			post.push_back(std::make_pair(constant(_context, v, CURRENT), constant(_context, v, lvalmap.at(v))));
+
+	z3::expr formula = invariant(fun, edge.src) && con->z3(_context) && !substitute(invariant(fun, edge.dst), post);
+	discharge(formula, fun, "edge " + std::to_string(edge.src) + " -> " + std::to_string(edge.dst));
+}
+
+void CertificateChecker::check_call(const ast::FunDef* fun, const ast::FlowGraph::Edge& edge, const ast::FunDef* callee) {
+	// entry: the callee starts with its globals on entry set to the current ones and arbitrary locals
+	std::vector<std::pair<z3::expr, z3::expr>> entry, ret, post;
+	for (const ast::VarDef* v : visible_vars(_program, NULL)) {
+		entry.push_back(std::make_pair(constant(_context, v, ENTRY), constant(_context, v, CURRENT)));
+		ret.push_back(std::make_pair(constant(_context, v, ENTRY), constant(_context, v, CURRENT)));
+		ret.push_back(std::make_pair(constant(_context, v, CURRENT), constant(_context, v, NEXT)));
+		post.push_back(std::make_pair(constant(_context, v, CURRENT), constant(_context, v, NEXT)));
+	}
+	for (const auto& e : callee->name2var())
+		entry.push_back(std::make_pair(constant(_context, e.second, CURRENT), constant(_context, e.second, CALLEE)));
+
+	z3::expr pre = invariant(fun, edge.src);
+	discharge(pre && !substitute(invariant(callee, _flow.at(callee)->entry()), entry), fun, "call of '" + callee->name() + "' at " + std::to_string(edge.src));
+
+	// return: globals are updated according to the summary, locals are kept
+	z3::expr formula = pre && substitute(summary(callee), ret) && !substitute(invariant(fun, edge.dst), post);
+	discharge(formula, fun, "return from '" + callee->name() + "' to " + std::to_string(edge.dst));
+}
+
+bool CertificateChecker::check() {
+	// main is entered with arbitrary values
+	const ast::FunDef* main = _program.name2fun().at("main");
+	z3::expr init = _context.bool_val(true);
+	for (const ast::VarDef* v : visible_vars(_program, NULL))
+		init = init && constant(_context, v, ENTRY) == constant(_context, v, CURRENT);
+	discharge(init && !invariant(main, _flow.at(main)->entry()), main, "initial states");
+
+	for (const auto& f : _flow) {
+		for (const auto& edge : f.second->edges()) {
+			const ast::Call* call = dynamic_cast<const ast::Call*>(edge.stmt);
+			if (call == NULL) check_edge(f.first, edge);
+			else check_call(f.first, edge, call->decl());
+		}
+		discharge(invariant(f.first, f.second->exit()) && !summary(f.first), f.first, "summary");
+	}
+
+	return _failures == 0;
+}
+
+bool cegar::check_certificate(const ast::Program& program, const Certificate& certificate) {
+	CertificateChecker checker(program, certificate);
+	bool valid = checker.check();
+	/*output*/std::cout << "Checked " << checker.obligations() << " obligations, " << checker.failures() << " violated." << std::endl;
+	return valid;
+}
+
+bool cegar::check_certificate(std::string filename, std::string certfile) {
+	auto clk_begin = clock();
+
+	std::unique_ptr<ast::Program> program(load_program(filename));
+	program->prettyprint(std::cout);
+
+	std::ifstream is(certfile);
+	if (!is) throw ast::ValidationError("Cannot open certificate file '" + certfile + "'.");
+	bool valid = check_certificate(*program, read_certificate(is));
+
+	/*output*/std::cout << std::endl;
+	if (valid) {
+		/*output*/std::cout << "   +-----------------------+" << std::endl;
+		/*output*/std::cout << "   | Certificate is VALID! |" << std::endl;
+		/*output*/std::cout << "   +-----------------------+" << std::endl;
+	} else {
+		/*output*/std::cout << "   +-------------------------+" << std::endl;
+		/*output*/std::cout << "   | Certificate is INVALID! |" << std::endl;
+		/*output*/std::cout << "   +-------------------------+" << std::endl;
+	}
+	/*output*/std::cout << std::endl;
+	/*output*/std::cout << "Total Time Taken: " << (clock()-clk_begin)/1000/1000.0 << "s" << std::endl;
+	return valid;
+}
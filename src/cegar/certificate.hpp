@@ -0,0 +1,81 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <iostream>
+#include "cuddObj.hh"
+#include "ast/ast.hpp"
+#include "symbolic/ControlFlowGraph.hpp"
+
+
+namespace cegar {
+
+
+	/**
+	 * @brief Inductive invariants witnessing the correctness of a program.
+	 * @details Invariants are given for the locations of the FlowGraph s computed by
+	 *          ```ast::FunDef::flow```, summaries relate the global variables on entry
+	 *          and on exit of a function. Both are SMT-LIB terms over ```scope%name$1```
+	 *          denoting the current value of a variable and ```global%name$0``` denoting
+	 *          the value of a global variable on entry of the enclosing function.
+	 *          Missing invariants are ```false```, i.e. the location is unreachable.
+	 *          Missing summaries are ```false```, i.e. the function never returns.
+	 */
+	struct Certificate {
+		std::map<std::pair<std::string, std::size_t>, std::string> invariants;
+		std::map<std::string, std::string> summaries;
+	};
+
+
+	/**
+	 * @brief Converts the outcome of a successful reachability analysis of an abstraction into a Certificate.
+	 * @details The configurations reachable at the node of a location are a disjunction of cubes over
+	 *          the predicates; those are translated back into formulas over program variables.
+	 *
+	 * @see symbolic::reachable
+	 * @see ast::FunDef::locate
+	 * @param program the concrete program
+	 * @param abstract the abstraction of ```program``` the ControlFlowGraph ```cfg``` was created for
+	 * @param predicates the predicates ```abstract``` was created for
+	 * @param cfg the ControlFlowGraph of ```abstract```
+	 * @param relation the configurations reachable inside of procedures (incl. the valuation on entry)
+	 * @return a certificate for ```program```
+	 */
+	Certificate extract_certificate(const ast::Program& program, const ast::Program& abstract, const ast::PredicateList& predicates, const symbolic::ControlFlowGraph& cfg, const BDD relation);
+
+	/**
+	 * @brief Writes a Certificate line by line: ```invariant <function> <location> <term>``` and ```summary <function> <term>```.
+	 */
+	void write_certificate(std::ostream& os, const Certificate& certificate);
+
+	/**
+	 * @brief Reads a Certificate written by ```cegar::write_certificate```.
+	 * @throws ast::ValidationError if the input is malformed
+	 */
+	Certificate read_certificate(std::istream& is);
+
+	/**
+	 * @brief Checks whether the given Certificate proves the given program correct.
+	 * @details Every edge of every FlowGraph yields a single SMT query: the invariant of its source
+	 *          and the statement must imply the invariant of its destination (```false``` for error
+	 *          locations). Calls yield two queries, one establishing the invariant on entry of the
+	 *          callee and one applying its summary. Additionally, the invariant on exit of a function
+	 *          must imply its summary and the invariant on entry of ```main``` must hold initially.
+	 *
+	 * @param program a validated program
+	 * @param certificate the certificate to check
+	 * @return ```true``` iff. all queries are unsatisfiable
+	 */
+	bool check_certificate(const ast::Program& program, const Certificate& certificate);
+
+	/**
+	 * @brief Checks a certificate file against a program file.
+	 * @see cegar::check_certificate
+	 * @param filename path to a file containing the program
+	 * @param certfile path to a file containing the certificate
+	 * @return ```true``` iff. the certificate is valid
+	 */
+	bool check_certificate(std::string filename, std::string certfile);
+
+
+}
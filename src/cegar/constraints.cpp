@@ -9,24 +9,58 @@ std::vector<ast::Expr*> cegar::compute_constraints(const std::vector<const ast::
 	// push/pop current map when call/return found
 	std::vector<ast::Expr*> result;
 
-	std::stack<std::map<const ast::VarDef*, std::size_t>> maps;
-	maps.push(std::map<const ast::VarDef*, std::size_t>());
+	std::stack<ast::VersionMap> maps;
+	maps.push(ast::VersionMap());
+
+	// every frame continues with versions unused so far for the locals of its function (cf. VersionMap::highest)
+	// such that recursive calls never share symbols for local variables; copying a frame is cheap, and calls
+	// and returns only touch the locals of the callee and the globals it assigns
+	std::stack<const ast::FunDef*> funs;
+	funs.push(NULL);
 
 	for (const ast::TraceableStatement* stmt : trace) {
-		auto& lvm = maps.top();
+		std::vector<ast::Expr*> links;
 
-		// pop/push lvalue maps when handling call/return to properly handle function calls
-		if (dynamic_cast<const ast::Call*>(stmt)) maps.push(std::map<const ast::VarDef*, std::size_t>(lvm));
-		else if (dynamic_cast<const ast::Return*>(stmt)) {
+		// pop/push version maps when handling call/return to properly handle function calls
+		if (const ast::Call* call = dynamic_cast<const ast::Call*>(stmt)) {
+			ast::VersionMap frame(maps.top());
+			for (const auto& e : call->decl()->name2var()) {
+				auto it = frame.highest().find(e.second);
+				if (it != frame.highest().end()) frame.set(e.second, it->second + 1);
+			}
+			maps.push(frame);
+			funs.push(call->decl());
+		} else if (dynamic_cast<const ast::Return*>(stmt)) {
 			auto top = maps.top();
 			maps.pop();
 			// global variables should remain in the stack
-			for (const auto& e : top)
+			for (const auto& e : top.changes(maps.top()))
 				if (e.first->function() == NULL)
-					maps.top()[e.first] = e.second;
+					maps.top().set(e.first, e.second);
+			// locals of a recursive caller move on to versions unused by the callee; values are kept
+			const ast::FunDef* callee = funs.top();
+			funs.pop();
+			auto& caller = maps.top();
+			if (callee != NULL) for (const auto& e : callee->name2var()) {
+				const ast::VarDef* var = e.second;
+				auto highest = caller.highest().find(var);
+				const std::size_t* current = caller.find(var);
+				bool known = current != NULL;
+				std::size_t old = known ? *current : 0;
+				if (highest == caller.highest().end() || highest->second <= old) continue;
+				std::size_t version = highest->second + 1;
+				caller.set(var, version);
+				if (known) links.push_back(new ast::BinaryExpression(ast::cmp_eq, new ast::SymbolicConstant(var, version), new ast::SymbolicConstant(var, old)));
+			}
 		}
 
-		result.push_back(stmt->con(lvm));
+		ast::Expr* con = stmt->con(maps.top());
+
+		for (ast::Expr* link : links)
+			con = new ast::BinaryExpression(ast::log_and, link, con);
+		// constraints are submitted to the solver as they are
+		std::unique_ptr<ast::Expr> raw(con);
+		result.push_back(raw->simplify());
 	}
 
 	return result;
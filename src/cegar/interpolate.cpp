@@ -1,15 +1,83 @@
 #include "cegar/interpolate.hpp"
 
 #include "ast/abstraction_utils.hpp"
+#include "ast/query_log.hpp"
+#include "ast/query_limits.hpp"
+#include "ast/term_cache.hpp"
+#include "checks.hpp"
 #include <iostream>
+#include <sstream>
+#include <chrono>
 #include <string>
 #include <vector>
 #include <stack>
+#include <set>
+#include <map>
 #include <z3++.h>
 
 using namespace cegar;
 
 
+/******************************************************************************
+	Helpers
+ ******************************************************************************/
+
+static void collect_symbols(const z3::expr& expr, std::map<std::string, z3::expr>& symbols) {
+	if (!expr.is_app()) return;
+	if (expr.is_const() && !expr.is_numeral() && expr.decl().decl_kind() == Z3_OP_UNINTERPRETED) {
+		symbols.emplace(expr.decl().name().str(), expr);
+		return;
+	}
+	for (unsigned int i = 0; i < expr.num_args(); i++)
+		collect_symbols(expr.arg(i), symbols);
+}
+
+static bool is_global(const std::map<std::string, const ast::VarDef*>& decls, const std::string& symbol) {
+	auto it = decls.find(symbol);
+	return it != decls.end() && it->second->function() == NULL;
+}
+
+static bool is_convertible(const z3::expr& expr) {
+	// cf. ast::z3expr2expr
+	static const std::set<std::string> ops = { "not", "and", "or", "=", "<", "<=", ">", ">=", "+", "-", "*" };
+	if (!expr.is_app()) return false;
+	if (expr.is_const()) return expr.is_numeral() || expr.decl().decl_kind() == Z3_OP_UNINTERPRETED || expr.is_true() || expr.is_false();
+	if (ops.count(expr.decl().name().str()) == 0) return false;
+	for (unsigned int i = 0; i < expr.num_args(); i++)
+		if (!is_convertible(expr.arg(i))) return false;
+	return true;
+}
+
+static z3::expr project(z3::context& ctx, const z3::expr& caller, const z3::expr& interpolant, const std::set<std::string>& keep) {
+	// interpolants within a callee may relate the globals on entry (shared with the caller) to the current state;
+	// conjoined with the interpolant of the caller and projected onto the current state they become state formulas
+	z3::expr conj = caller && interpolant;
+	std::map<std::string, z3::expr> symbols;
+	collect_symbols(conj, symbols);
+	z3::expr_vector bound(ctx);
+	for (const auto& e : symbols)
+		if (keep.count(e.first) == 0)
+			bound.push_back(e.second);
+	if (bound.size() == 0) return conj;
+
+	z3::goal goal(ctx);
+	goal.add(z3::exists(bound, conj));
+	z3::apply_result subgoals = z3::tactic(ctx, "qe")(goal);
+	z3::expr result = ctx.bool_val(false);
+	for (unsigned int i = 0; i < subgoals.size(); i++) {
+		z3::expr sub = ctx.bool_val(true);
+		for (unsigned int j = 0; j < subgoals[i].size(); j++) sub = sub && subgoals[i][j];
+		result = result || sub;
+	}
+	return is_convertible(result) ? result.simplify() : interpolant;
+}
+
+
+/******************************************************************************
+	Interpolation
+ ******************************************************************************/
+
+
 std::pair<bool, z3::expr> cegar::interpolate(z3::context& ctx, const z3::expr minus, const z3::expr plus) {
 	// z3::solver bla(ctx);
 	// bla.push();
@@ -24,12 +92,15 @@ std::pair<bool, z3::expr> cegar::interpolate(z3::context& ctx, const z3::expr mi
 	// Z3_ast patParts[] = {A, Z3_mk_interpolant(ctx, B)};
 	Z3_ast pat = Z3_mk_and(ctx, 2, patParts);
 
-	Z3_params params = 0;
+	z3::params params = ast::QueryLimits::instance().params(ctx);
 	Z3_ast_vector interpolants;
 	Z3_model model = 0;
 	Z3_lbool status;
 
+	auto clk_begin = std::chrono::steady_clock::now();
 	status = Z3_compute_interpolant(ctx, pat, params, &interpolants, &model);
+	std::string result = status == Z3_L_FALSE ? "unsat" : (status == Z3_L_TRUE ? "sat" : "unknown");
+	ast::QueryLog::instance().record(minus && plus, result, std::chrono::duration<double>(std::chrono::steady_clock::now() - clk_begin).count());
 	
 	if (status == Z3_L_FALSE) {
 		assert(Z3_ast_vector_size(ctx, interpolants) == 1);
@@ -37,9 +108,11 @@ std::pair<bool, z3::expr> cegar::interpolate(z3::context& ctx, const z3::expr mi
 		z3::expr interpolant(ctx, ast);
 
 		// test interpolante
-		z3::solver solver(ctx);
-		assert(ast::implies(solver, minus, interpolant));
-		assert(!ast::is_taut(solver, interpolant&&plus));
+		if (CHECK_EXPENSIVE) {
+			z3::solver solver(ctx);
+			assert_expensive(ast::implies(solver, minus, interpolant));
+			assert_expensive(!ast::is_taut(solver, interpolant&&plus));
+		}
 
 		return std::make_pair(true, interpolant);
 	} else {
@@ -47,47 +120,157 @@ std::pair<bool, z3::expr> cegar::interpolate(z3::context& ctx, const z3::expr mi
 			std::cout << "MODEL FOUND: " << std::endl << Z3_model_to_string(ctx, model) << std::endl;
 			Z3_del_model(ctx, model);
 		}
-		assert(false);
+		// the solver may give up due to ast::QueryLimits; the formula must not be satisfiable though
+		assert(status == Z3_L_UNDEF);
 		return std::make_pair(false, z3::expr(ctx));
 	}
 }
 
+std::pair<bool, std::vector<z3::expr>> cegar::nested_interpolate(z3::context& ctx, const std::vector<z3::expr>& constraints, const std::vector<Nesting>& nesting) {
+	assert(constraints.size() > 0);
+	assert(constraints.size() == nesting.size());
+
+	// the pattern is a tree with one node per position: a node has the previous position of the same procedure
+	// as child; the node of a return additionally has the node before the matching call as child
+	// -> interpolants within a callee do not see the caller, interpolants of the caller skip the callee
+	std::vector<std::vector<std::size_t>> children(constraints.size());
+	std::vector<z3::expr> nodes;
+	std::stack<std::size_t> calls;
+	for (std::size_t i = 0; i < constraints.size(); i++) {
+		if (nesting.at(i) == CALL) {
+			calls.push(i);
+		} else if (nesting.at(i) == RETURN && !calls.empty()) {
+			if (calls.top() > 0) children.at(i).push_back(calls.top() - 1);
+			children.at(i).push_back(i - 1);
+			calls.pop();
+		} else if (i > 0) {
+			children.at(i).push_back(i - 1);
+		}
+	}
+	// the root gathers all pending callers
+	std::vector<std::size_t> root_children;
+	for (; !calls.empty(); calls.pop())
+		if (calls.top() > 0) root_children.insert(root_children.begin(), calls.top() - 1);
+
+	// children occur in order, so the post-order of the pattern follows the positions
+	for (std::size_t i = 0; i < constraints.size(); i++) {
+		z3::expr node = constraints.at(i);
+		for (auto it = children.at(i).rbegin(); it != children.at(i).rend(); it++)
+			node = nodes.at(*it) && node;
+		nodes.push_back(i+1 < constraints.size() ? z3::expr(ctx, Z3_mk_interpolant(ctx, node)) : node);
+	}
+	z3::expr pat = nodes.back();
+	for (auto it = root_children.rbegin(); it != root_children.rend(); it++)
+		pat = nodes.at(*it) && pat;
+
+	z3::params params = ast::QueryLimits::instance().params(ctx);
+	Z3_ast_vector interpolants;
+	Z3_model model = 0; // always written by Z3, never used
+	Z3_lbool status;
+
+	auto clk_begin = std::chrono::steady_clock::now();
+	status = Z3_compute_interpolant(ctx, pat, params, &interpolants, &model);
+	if (model) Z3_del_model(ctx, model);
+	std::string result = status == Z3_L_FALSE ? "unsat" : (status == Z3_L_TRUE ? "sat" : "unknown");
+	z3::expr conj = constraints.at(0);
+	for (std::size_t i = 1; i < constraints.size(); i++) conj = conj && constraints.at(i);
+	ast::QueryLog::instance().record(conj, result, std::chrono::duration<double>(std::chrono::steady_clock::now() - clk_begin).count());
+
+	std::vector<z3::expr> tree;
+	if (status == Z3_L_FALSE) {
+		// interpolants come in post-order of the pattern, i.e. in the order of the positions
+		assert(Z3_ast_vector_size(ctx, interpolants) == constraints.size() - 1);
+		for (unsigned int i = 0; i < Z3_ast_vector_size(ctx, interpolants); i++)
+			tree.push_back(z3::expr(ctx, Z3_ast_vector_get(ctx, interpolants, i)));
+
+		// test interpolants: the interpolants of the children and the constraint imply the interpolant of a node
+		if (CHECK_EXPENSIVE) {
+			z3::solver solver(ctx);
+			for (std::size_t i = 0; i < constraints.size(); i++) {
+				z3::expr pre = constraints.at(i);
+				for (std::size_t c : children.at(i)) pre = tree.at(c) && pre;
+				if (i+1 == constraints.size()) for (std::size_t c : root_children) pre = tree.at(c) && pre;
+				assert_expensive(ast::implies(solver, pre, i+1 < constraints.size() ? tree.at(i) : ctx.bool_val(false)));
+			}
+		}
+
+		return std::make_pair(true, tree);
+	} else {
+		assert(status == Z3_L_UNDEF);
+		return std::make_pair(false, tree);
+	}
+}
+
 std::vector<ast::Expr*> cegar::compute_interpolants(const ast::Program& prog, const std::vector<const ast::TraceableStatement*>& trace, const std::vector<ast::Expr*>& constraints) {
 	// constraints might contain variables with the same name which however stem from different function declarations
 	// -> properly translate variables to prefixed (with scope name) z3 variables and undo this in the end
 
 	// TODO: programs must not have duplicate variable declarations -> oryl?
 	z3::context ctx;
+	ast::TermCache terms(ctx);
 
 	std::vector<z3::expr> z3c;
 	for (const ast::Expr* e : constraints)
 		z3c.push_back(e->z3(ctx));
+	auto decls = terms.decls();
 
-	std::vector<ast::Expr*> interpolants;
-	std::stack<std::size_t> funbodies;
-	funbodies.push(0);
-	for (std::size_t i = 0; i < z3c.size() - 1; i++) {
-		// auto stmt = trace.at(i);
-		// if (dynamic_cast<const ast::Call*>(stmt)) {
-		//	funbodies.push(i+1);
-		//	continue; // TODO: correct?
-		// } else if (dynamic_cast<const ast::Return*>(stmt)) {
-		//	funbodies.pop();
-		//	continue; // TODO: correct?
-		// }
-		// auto stack_pointer = funbodies.top();
-		auto stack_pointer = 0;
-		// minus = contraints[0] && ... && contraints[i]
-		z3::expr minus = z3c.at(stack_pointer);
-		for (std::size_t j = stack_pointer+1; j <= i; j++) minus = minus && z3c.at(j);
-		// plus  = contraints[i+1] && ... && contraints[constraints.size()-1]
-		z3::expr plus = z3c.at(i+1);
-		for (std::size_t j = i+2; j <= z3c.size()-1; j++) plus = plus && z3c.at(j);
-		// make interpolant
-		auto res = interpolate(ctx, minus, plus);
-		assert(res.first);
-		interpolants.push_back(ast::z3expr2expr(res.second));
+	// all interpolants stem from a single refutation of the whole trace
+	std::vector<Nesting> nesting;
+	for (const ast::TraceableStatement* stmt : trace) {
+		if (dynamic_cast<const ast::Call*>(stmt)) nesting.push_back(CALL);
+		else if (dynamic_cast<const ast::Return*>(stmt)) nesting.push_back(RETURN);
+		else nesting.push_back(INTERNAL);
+	}
+	std::stringstream desc;
+	desc << "trace of length " << trace.size();
+	ast::QueryOrigin origin("interpolation", desc.str());
+	auto res = nested_interpolate(ctx, z3c, nesting);
+	if (!res.first) {
+		// the solver gave up; interpolate every cut point on its own and drop those exceeding the limits as well
+		ast::QueryLimits& limits = ast::QueryLimits::instance();
+		for (std::size_t i = 0; i+1 < z3c.size(); i++) {
+			z3::expr minus = z3c.at(0), plus = z3c.at(i+1);
+			for (std::size_t j = 1; j <= i; j++) minus = minus && z3c.at(j);
+			for (std::size_t j = i+2; j < z3c.size(); j++) plus = plus && z3c.at(j);
+			auto cut = interpolate(ctx, minus, plus);
+			if (!cut.first) limits.interpolation_fallback();
+			res.second.push_back(cut.first ? cut.second : ctx.bool_val(true));
+		}
+	}
+
+	// symbols used after a position, and before a position
+	std::vector<std::set<std::string>> later(z3c.size()), earlier(z3c.size());
+	std::map<std::string, z3::expr> symbols;
+	for (std::size_t i = z3c.size(); i-- > 0;) {
+		for (const auto& e : symbols) later.at(i).insert(e.first);
+		collect_symbols(z3c.at(i), symbols);
+	}
+	symbols.clear();
+	for (std::size_t i = 0; i < z3c.size(); i++) {
+		for (const auto& e : symbols) earlier.at(i).insert(e.first);
+		collect_symbols(z3c.at(i), symbols);
 	}
 
+	// within a callee, keep the globals and the locals of the callee's frame that are still in use
+	std::vector<z3::expr> scoped;
+	std::stack<std::size_t> calls;
+	for (std::size_t i = 0; i < res.second.size(); i++) {
+		if (nesting.at(i) == CALL) calls.push(i);
+		else if (nesting.at(i) == RETURN && !calls.empty()) calls.pop();
+
+		if (calls.empty() || calls.top() == 0) {
+			scoped.push_back(res.second.at(i));
+			continue;
+		}
+		std::set<std::string> keep;
+		for (const std::string& symbol : later.at(i))
+			if (is_global(decls, symbol) || earlier.at(calls.top()).count(symbol) == 0)
+				keep.insert(symbol);
+		scoped.push_back(project(ctx, scoped.at(calls.top() - 1), res.second.at(i), keep));
+	}
+
+	std::vector<ast::Expr*> interpolants;
+	for (const z3::expr& interpolant : scoped)
+		interpolants.push_back(ast::z3expr2expr(interpolant));
 	return interpolants;
 }
@@ -8,6 +8,26 @@ namespace cegar {
 
 	std::pair<bool, z3::expr> interpolate(z3::context& ctx, const z3::expr minus, const z3::expr plus);
 
+	/**
+	 * @brief Role of a constraint in the call/return structure of a trace.
+	 */
+	enum Nesting { INTERNAL, CALL, RETURN };
+
+	/**
+	 * @brief Computes nested interpolants for the given constraints with a single solver call.
+	 * @details For unsatisfiable ```c_0 && ... && c_{n-1}```, computes ```I_0, ..., I_{n-2}``` such that
+	 *          ```I_{n-2} && c_{n-1} -> false``` and every ```I_i``` only mentions symbols shared by
+	 *          ```c_0, ..., c_i``` and ```c_{i+1}, ..., c_{n-1}```. Without calls, this is a sequence
+	 *          interpolant, i.e. ```c_0 -> I_0``` and ```I_{i-1} && c_i -> I_i```. Otherwise, the call/return
+	 *          structure of the trace is followed: the interpolant after a call only needs to be implied by
+	 *          the call, the interpolant after the matching return by the interpolants before the call and
+	 *          before the return. Hence, interpolants within a callee never mention symbols local to its callers.
+	 * @param nesting the role of every constraint; returns without matching call are treated as ```INTERNAL```
+	 * @return ```true``` and the ```n-1``` interpolants iff. the conjunction of the constraints is unsatisfiable;
+	 *         ```false``` if the solver gives up due to ```ast::QueryLimits```
+	 */
+	std::pair<bool, std::vector<z3::expr>> nested_interpolate(z3::context& ctx, const std::vector<z3::expr>& constraints, const std::vector<Nesting>& nesting);
+
 	std::vector<ast::Expr*> compute_interpolants(const ast::Program& prog, const std::vector<const ast::TraceableStatement*>& trace, const std::vector<ast::Expr*>& constraints);
 	
 	// static void intertest() {
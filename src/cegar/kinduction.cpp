@@ -0,0 +1,224 @@
+#include "cegar/kinduction.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include "ast/ast.hpp"
+#include "cegar/cegar.hpp"
+#include "cegar/lazy.hpp"
+
+using namespace cegar;
+
+
+typedef std::pair<const ast::FunDef*, std::size_t> Location;
+
+
+/******************************************************************************
+	Transition System
+ ******************************************************************************/
+
+struct Transition {
+	std::size_t src;
+	std::size_t dst;
+	const ast::TraceableStatement* stmt;
+};
+
+class TransitionSystem {
+	// all functions inlined into one graph; the program counter identifies a location of some inlined copy
+	private:
+		z3::context& _context;
+		std::map<const ast::FunDef*, std::unique_ptr<ast::FlowGraph>> _flow;
+		std::vector<const ast::VarDef*> _vars;
+		std::vector<Transition> _transitions;
+		std::vector<Location> _origin;
+		std::map<Location, std::unique_ptr<ast::Expr>> _invariants;
+		std::size_t _entry;
+		std::size_t _error;
+		ast::Return _return;
+
+		std::pair<std::size_t, std::size_t> instantiate(const ast::FunDef* fun, std::vector<const ast::FunDef*>& stack);
+		z3::expr rename(const ast::Expr& expr, std::size_t step) const;
+
+	public:
+		TransitionSystem(const ast::Program& prog, z3::context& context);
+		void strengthen(std::map<Location, ast::Expr*> invariants);
+		std::size_t size() const { return _origin.size(); }
+		z3::expr pc(std::size_t step) const;
+		z3::expr init() const;
+		z3::expr error(std::size_t step) const;
+		z3::expr transition(std::size_t step) const;
+		z3::expr invariant(std::size_t step) const;
+};
+
+
+TransitionSystem::TransitionSystem(const ast::Program& prog, z3::context& context) : _context(context) {
+	for (const auto& e : prog.name2var())
+		_vars.push_back(e.second);
+	for (const auto& f : prog.name2fun()) {
+		for (const auto& e : f.second->name2var())
+			_vars.push_back(e.second);
+		_flow[f.second].reset(f.second->flow());
+	}
+
+	_error = 0;
+	_origin.push_back(std::make_pair(nullptr, 0));
+	std::vector<const ast::FunDef*> stack;
+	_entry = instantiate(prog.name2fun().at("main"), stack).first;
+}
+
+std::pair<std::size_t, std::size_t> TransitionSystem::instantiate(const ast::FunDef* fun, std::vector<const ast::FunDef*>& stack) {
+	if (std::find(stack.begin(), stack.end(), fun) != stack.end())
+		throw ast::UnsupportedOperationError("Recursive call of '" + fun->name() + "()' cannot be inlined.");
+	stack.push_back(fun);
+
+	const ast::FlowGraph& graph = *_flow.at(fun);
+	std::vector<std::size_t> pcs;
+	for (std::size_t loc = 0; loc < graph.size(); loc++) {
+		if (loc == graph.error()) {
+			pcs.push_back(_error);
+		} else {
+			pcs.push_back(_origin.size());
+			_origin.push_back(std::make_pair(fun, loc));
+		}
+	}
+
+	for (const auto& edge : graph.edges()) {
+		const ast::Call* call = dynamic_cast<const ast::Call*>(edge.stmt);
+		if (call == NULL) {
+			_transitions.push_back({ pcs.at(edge.src), pcs.at(edge.dst), edge.stmt });
+		} else {
+			auto callee = instantiate(call->decl(), stack);
+			_transitions.push_back({ pcs.at(edge.src), callee.first, call });
+			_transitions.push_back({ callee.second, pcs.at(edge.dst), &_return });
+		}
+	}
+
+	stack.pop_back();
+	return std::make_pair(pcs.at(graph.entry()), pcs.at(graph.exit()));
+}
+
+void TransitionSystem::strengthen(std::map<Location, ast::Expr*> invariants) {
+	for (const auto& e : invariants)
+		_invariants[e.first].reset(e.second);
+}
+
+z3::expr TransitionSystem::rename(const ast::Expr& expr, std::size_t step) const {
+	ast::VersionMap lvalmap;
+	for (const ast::VarDef* v : _vars) lvalmap.set(v, step);
+	ast::Assume tmp(expr.copy());
+	std::unique_ptr<ast::Expr> con(tmp.con(lvalmap));
+	return con->z3(_context);
+}
+
+z3::expr TransitionSystem::pc(std::size_t step) const {
+	return _context.int_const(("pc$" + std::to_string(step)).c_str());
+}
+
+z3::expr TransitionSystem::init() const {
+	return pc(0) == _context.int_val((unsigned) _entry);
+}
+
+z3::expr TransitionSystem::error(std::size_t step) const {
+	return pc(step) == _context.int_val((unsigned) _error);
+}
+
+z3::expr TransitionSystem::transition(std::size_t step) const {
+	// variables are renamed to 'step' and 'step+1' just like TraceableStatement::con does for traces
+	z3::expr result = _context.bool_val(false);
+	for (const Transition& t : _transitions) {
+		ast::VersionMap lvalmap;
+		for (const ast::VarDef* v : _vars) lvalmap.set(v, step);
+		std::unique_ptr<ast::Expr> con(t.stmt->con(lvalmap));
+
+		z3::expr trans = pc(step) == _context.int_val((unsigned) t.src) && pc(step+1) == _context.int_val((unsigned) t.dst) && con->z3(_context);
+		for (const ast::VarDef* v : _vars)
+			if (lvalmap.at(v) == step)
+				trans = trans && ast::SymbolicConstant(v, step+1).z3(_context) == ast::SymbolicConstant(v, step).z3(_context);
+		result = result || trans;
+	}
+	return result;
+}
+
+z3::expr TransitionSystem::invariant(std::size_t step) const {
+	z3::expr result = _context.bool_val(true);
+	for (std::size_t i = 0; i < _origin.size(); i++) {
+		auto it = _invariants.find(_origin.at(i));
+		if (it == _invariants.end()) continue;
+		result = result && z3::implies(pc(step) == _context.int_val((unsigned) i), rename(*it->second, step));
+	}
+	return result;
+}
+
+
+/******************************************************************************
+	Helpers
+ ******************************************************************************/
+
+z3::check_result check_goal(z3::solver& solver, std::string name, const z3::expr& goal) {
+	// goal is only enabled for this query
+	z3::context& context = solver.ctx();
+	z3::expr act = context.bool_const(name.c_str());
+	solver.add(z3::implies(act, goal));
+	z3::expr_vector assumptions(context);
+	assumptions.push_back(act);
+	return solver.check(assumptions);
+}
+
+
+/******************************************************************************
+	k-Induction
+ ******************************************************************************/
+
+bool cegar::prove_kinduction(std::string filename, const Options& options) {
+	auto clk_begin = clock();
+
+	std::unique_ptr<ast::Program> program(load_program(filename));
+	program->prettyprint(std::cout);
+
+	z3::context context;
+	TransitionSystem sts(*program, context);
+	sts.strengthen(compute_invariants(*program, options));
+	/*output*/std::cout << "Transition system with " << sts.size() << " locations." << std::endl;
+
+	z3::solver base(context), step(context);
+	base.add(sts.init());
+	step.add(sts.invariant(0));
+
+	for (std::size_t k = 0; k <= options.bound; k++) {
+		/*output*/std::cout << "Checking k = " << k << "..." << std::endl;
+
+		// base case: error reachable in k steps?
+		if (k > 0) base.add(sts.transition(k-1));
+		if (check_goal(base, "base$" + std::to_string(k), sts.error(k)) == z3::sat) {
+			/*output*/std::cout << std::endl;
+			/*output*/std::cout << "   +-------------------------+" << std::endl;
+			/*output*/std::cout << "   | Your programm is WRONG! |" << std::endl;
+			/*output*/std::cout << "   +-------------------------+" << std::endl;
+			/*output*/std::cout << std::endl;
+			/*output*/std::cout << "Total Time Taken: " << (clock()-clk_begin)/1000/1000.0 << "s" << std::endl;
+			return false;
+		}
+
+		// step case: k+1 safe states are followed by a safe one?
+		step.add(!sts.error(k));
+		step.add(sts.transition(k));
+		step.add(sts.invariant(k+1));
+		if (check_goal(step, "step$" + std::to_string(k+1), sts.error(k+1)) == z3::unsat) {
+			/*output*/std::cout << std::endl;
+			/*output*/std::cout << "   +---------------------------+" << std::endl;
+			/*output*/std::cout << "   | Your programm is CORRECT! |" << std::endl;
+			/*output*/std::cout << "   +---------------------------+" << std::endl;
+			/*output*/std::cout << std::endl;
+			/*output*/std::cout << "Proven " << k+1 << "-inductive." << std::endl;
+			/*output*/std::cout << "Total Time Taken: " << (clock()-clk_begin)/1000/1000.0 << "s" << std::endl;
+			return true;
+		}
+	}
+
+	/*output*/std::cout << std::endl;
+	/*output*/std::cout << "   +----------------------------+" << std::endl;
+	/*output*/std::cout << "   | Sorry, k-induction failed! |" << std::endl;
+	/*output*/std::cout << "   +----------------------------+" << std::endl;
+	/*output*/std::cout << std::endl;
+	/*output*/std::cout << "Total Time Taken: " << (clock()-clk_begin)/1000/1000.0 << "s" << std::endl;
+	throw Inconclusive("Not k-inductive within the bound.");
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <string>
+#include "ast/ast.hpp"
+#include "cegar/options.hpp"
+
+
+namespace cegar {
+
+
+	/**
+	 * @brief Checks a C-like integer program for assertion errors using k-induction.
+	 * @details The FlowGraph s of all functions are inlined into a single transition system
+	 *          over a program counter and all program variables (hence, recursion is not supported).
+	 *          For ```k = 0, 1, ..., bound``` two incremental queries are posed:
+	 *          1. base case: is the error location reachable in exactly ```k``` steps?
+	 *             if so, the program is incorrect
+	 *          2. step case: does every path of ```k+1``` steps that avoids the error
+	 *             location in the first ```k+1``` states avoid it in the next one, too?
+	 *             if so, the program is correct
+	 *          The step case is strengthened with location invariants computed by lazy
+	 *          abstraction with a limited number of refinements.
+	 *
+	 * @see cegar::compute_invariants
+	 * @param filename path to a file containing the program to check
+	 * @param options maximal induction depth (bound) and number of refinements
+	 *        spent on the strengthening invariants
+	 * @return ```true``` if the program is proven correct,
+	 *         ```false``` if the program is proven incorrect.
+	 * @throws Inconclusive if the program is not k-inductive for the given bound
+	 */
+	bool prove_kinduction(std::string filename, const Options& options=Options());
+
+
+}
@@ -0,0 +1,753 @@
+#include "cegar/lazy.hpp"
+
+#include <set>
+#include <deque>
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include "ast/ast.hpp"
+#include "ast/abstraction_utils.hpp"
+#include "ast/query_log.hpp"
+#include "cegar/cegar.hpp"
+#include "cegar/constraints.hpp"
+#include "cegar/interpolate.hpp"
+
+using namespace cegar;
+
+
+/******************************************************************************
+	Abstract States
+ ******************************************************************************/
+
+// conjunction of predicate literals (predicate id, value); sorted by predicate id
+typedef std::vector<std::pair<std::size_t, bool>> Cube;
+
+// disjunction of cubes; the empty disjunction is 'false'
+typedef std::vector<Cube> State;
+
+typedef std::pair<const ast::FunDef*, std::size_t> Location;
+
+
+bool subcube(const Cube& sub, const Cube& super) {
+	return std::includes(super.begin(), super.end(), sub.begin(), sub.end());
+}
+
+bool subsumes(const State& weak, const State& strong) {
+	// every cube of strong must be implied by some cube of weak
+	for (const Cube& s : strong) {
+		bool implied = false;
+		for (const Cube& w : weak)
+			if (subcube(w, s)) { implied = true; break; }
+		if (!implied) return false;
+	}
+	return true;
+}
+
+
+/******************************************************************************
+	Abstract Reachability Tree
+ ******************************************************************************/
+
+struct ArtNode;
+
+struct Invocation {
+	// a procedure unwound for a single abstract entry state
+	const ast::FunDef* fun;
+	State entry;
+	std::size_t depth;
+	std::unique_ptr<ArtNode> root;
+	std::vector<std::pair<ArtNode*, const ast::FlowGraph::Edge*>> callers; // call sites waiting for summaries
+	std::pair<ArtNode*, const ast::FlowGraph::Edge*> creator; // call site used to reconstruct traces; NULL for main
+	std::map<std::size_t, std::vector<ArtNode*>> at; // location -> nodes
+	std::vector<ArtNode*> exits;
+	std::vector<ArtNode*> errors;
+	std::vector<ArtNode*> suspended; // nodes not expanded since there is no creator
+
+	Invocation(const ast::FunDef* fun, State entry, std::size_t depth) : fun(fun), entry(entry), depth(depth), creator(NULL, NULL) {}
+};
+
+struct ArtNode {
+	const std::size_t id;
+	Invocation* const inv;
+	const std::size_t loc;
+	const State state;
+	ArtNode* const parent;
+	const ast::TraceableStatement* const stmt; // leads from parent to this node
+	ArtNode* const exit; // for summary edges: exit node of the callee providing the summary
+	std::vector<std::unique_ptr<ArtNode>> children;
+	std::vector<ArtNode*> dependents; // for exit nodes: summary edges created from this node
+	std::vector<Invocation*> called; // for call sites: invocations waiting on this node
+	ArtNode* covered_by = NULL;
+	std::vector<ArtNode*> covering;
+	bool expanded = false;
+
+	ArtNode(std::size_t id, Invocation* inv, std::size_t loc, State state, ArtNode* parent, const ast::TraceableStatement* stmt, ArtNode* exit)
+	       : id(id), inv(inv), loc(loc), state(state), parent(parent), stmt(stmt), exit(exit) {}
+};
+
+struct Step {
+	// executing stmt leads to node
+	const ast::TraceableStatement* stmt;
+	const ArtNode* node;
+};
+
+struct LazyPredicate {
+	std::unique_ptr<ast::Expr> expr;
+	z3::expr z3;
+	bool local; // mentions local variables
+
+	LazyPredicate(ast::Expr* expr, z3::expr z3) : expr(expr), z3(z3), local(expr->scope() != NULL) {}
+};
+
+template<typename T>
+void erase(std::vector<T>& vec, const T& val) {
+	vec.erase(std::remove(vec.begin(), vec.end(), val), vec.end());
+}
+
+
+/******************************************************************************
+	Lazy Abstraction
+ ******************************************************************************/
+
+class LazyAbstraction {
+	private:
+		const ast::Program& _prog;
+		const Options _options;
+		z3::context _context;
+		z3::solver _solver;
+		z3::expr_vector _globals;
+		std::map<const ast::FunDef*, z3::expr_vector> _locals;
+		std::map<const ast::FunDef*, std::unique_ptr<ast::FlowGraph>> _flow;
+		ast::Return _return;
+
+		std::vector<std::unique_ptr<LazyPredicate>> _preds;
+		std::map<std::string, std::size_t> _pred_ids;
+		std::map<Location, std::vector<std::size_t>> _precision;
+		std::map<std::pair<const ast::TraceableStatement*, std::size_t>, z3::expr> _images;
+		std::map<const ast::TraceableStatement*, z3::expr> _guards;
+
+		std::vector<std::unique_ptr<Invocation>> _invocations;
+		std::map<std::size_t, ArtNode*> _alive;
+		std::deque<std::size_t> _worklist;
+		std::size_t _next_id = 0;
+		std::size_t _fresh = 0;
+		std::size_t _refinements = 0;
+
+		const std::vector<std::size_t>& precision(const ast::FunDef* fun, std::size_t loc);
+		z3::expr formula(const State& state);
+		z3::expr rename(const z3::expr& expr, const z3::expr_vector& vars);
+		const z3::expr& image(const ast::TraceableStatement* stmt, std::size_t pred);
+		const z3::expr& guard(const ast::TraceableStatement* stmt);
+		State abstract(const z3::expr& psi, const std::vector<std::size_t>& preds, bool post_only_globals=false);
+
+		ArtNode* add_child(ArtNode* parent, std::size_t loc, State state, const ast::TraceableStatement* stmt, ArtNode* exit);
+		void expand(ArtNode* node);
+		void expand_call(ArtNode* node, const ast::FlowGraph::Edge* edge);
+		void add_summary(ArtNode* site, const ast::FlowGraph::Edge* edge, ArtNode* exit);
+		void add_exit(ArtNode* node);
+		void attach(Invocation* inv, ArtNode* site, const ast::FlowGraph::Edge* edge);
+		void detach(Invocation* inv, ArtNode* site);
+		bool cover(ArtNode* node);
+		void prune(ArtNode* node);
+		void reexpand(ArtNode* node);
+
+		void append_context(const Invocation* inv, std::vector<Step>& path) const;
+		void append_path(const ArtNode* node, std::vector<Step>& path) const;
+		bool is_feasible(const std::vector<Step>& path);
+		bool add_predicate(Location loc, ast::Expr* atom);
+		bool refine(const std::vector<Step>& path);
+		bool has_context(const Invocation* inv) const;
+		ast::Expr* expression(const State& state) const;
+
+	public:
+		LazyAbstraction(const ast::Program& prog, const Options& options);
+		bool run(bool complete=false);
+		std::map<Location, ast::Expr*> invariants() const;
+		std::size_t refinements() const { return _refinements; }
+		std::size_t nodes() const { return _alive.size(); }
+};
+
+
+LazyAbstraction::LazyAbstraction(const ast::Program& prog, const Options& options) : _prog(prog), _options(options), _solver(_context), _globals(_context) {
+	for (const auto& e : prog.name2var())
+		_globals.push_back(ast::VarName(e.second).z3(_context));
+
+	for (const auto& f : prog.name2fun()) {
+		z3::expr_vector locals(_context);
+		for (const auto& e : f.second->name2var())
+			locals.push_back(ast::VarName(e.second).z3(_context));
+		_locals.insert(std::make_pair(f.second, locals));
+		_flow[f.second].reset(f.second->flow());
+	}
+}
+
+
+/*** Abstraction ***/
+
+const std::vector<std::size_t>& LazyAbstraction::precision(const ast::FunDef* fun, std::size_t loc) {
+	return _precision[std::make_pair(fun, loc)];
+}
+
+z3::expr LazyAbstraction::formula(const State& state) {
+	z3::expr result = _context.bool_val(false);
+	for (const Cube& cube : state) {
+		z3::expr conj = _context.bool_val(true);
+		for (const auto& lit : cube) {
+			const z3::expr& p = _preds.at(lit.first)->z3;
+			conj = conj && (lit.second ? p : !p);
+		}
+		result = result || conj;
+	}
+	return result;
+}
+
+z3::expr LazyAbstraction::rename(const z3::expr& expr, const z3::expr_vector& vars) {
+	// replaces the given variables by fresh ones, i.e. existentially quantifies them
+	z3::expr_vector fresh(_context);
+	for (unsigned int i = 0; i < vars.size(); i++) {
+		std::string name = "lazy%" + std::to_string(_fresh++);
+		fresh.push_back(_context.constant(name.c_str(), vars[i].get_sort()));
+	}
+	z3::expr result = expr;
+	return result.substitute(vars, fresh);
+}
+
+const z3::expr& LazyAbstraction::image(const ast::TraceableStatement* stmt, std::size_t pred) {
+	// weakest precondition of a predicate wrt. a statement; cached as every edge is taken over and over again
+	auto key = std::make_pair(stmt, pred);
+	auto it = _images.find(key);
+	if (it == _images.end()) {
+		std::unique_ptr<ast::Expr> wp(stmt->wp(*_preds.at(pred)->expr));
+		it = _images.insert(std::make_pair(key, wp->z3(_context))).first;
+	}
+	return it->second;
+}
+
+const z3::expr& LazyAbstraction::guard(const ast::TraceableStatement* stmt) {
+	// the statement can be executed iff. its weakest precondition of 'false' does not hold
+	auto it = _guards.find(stmt);
+	if (it == _guards.end()) {
+		ast::Literal goal(false);
+		std::unique_ptr<ast::Expr> wp(stmt->wp(goal));
+		it = _guards.insert(std::make_pair(stmt, !wp->z3(_context))).first;
+	}
+	return it->second;
+}
+
+State LazyAbstraction::abstract(const z3::expr& psi, const std::vector<std::size_t>& preds, bool post_only_globals) {
+	// boolean abstraction of 'psi' over 'preds' by enumerating all satisfiable cubes
+	// note: psi is expected to already constrain the 'lazy$i' flags (cf. LazyAbstraction::expand)
+	std::vector<std::size_t> ids;
+	for (std::size_t p : preds)
+		if (!post_only_globals || !_preds.at(p)->local)
+			ids.push_back(p);
+	std::sort(ids.begin(), ids.end());
+
+	std::vector<z3::expr> flags;
+	for (std::size_t p : ids) {
+		std::string name = "lazy$" + std::to_string(p);
+		flags.push_back(_context.bool_const(name.c_str()));
+	}
+
+	State result;
+	_solver.push();
+	_solver.add(psi);
+	while (true) {
+		auto res = _solver.check();
+		if (res == z3::unsat) break;
+		if (res == z3::unknown) {
+			// be sound: give up precision
+			result = { Cube() };
+			break;
+		}
+
+		z3::model model = _solver.get_model();
+		Cube cube;
+		z3::expr block = _context.bool_val(false);
+		for (std::size_t i = 0; i < ids.size(); i++) {
+			bool val = Z3_get_bool_value(_context, model.eval(flags.at(i), true)) == Z3_L_TRUE;
+			cube.push_back(std::make_pair(ids.at(i), val));
+			block = block || (val ? !flags.at(i) : flags.at(i));
+		}
+		result.push_back(cube);
+		_solver.add(block);
+	}
+	_solver.pop();
+
+	return result;
+}
+
+
+/*** Construction ***/
+
+ArtNode* LazyAbstraction::add_child(ArtNode* parent, std::size_t loc, State state, const ast::TraceableStatement* stmt, ArtNode* exit) {
+	ArtNode* node = new ArtNode(_next_id++, parent->inv, loc, state, parent, stmt, exit);
+	parent->children.push_back(std::unique_ptr<ArtNode>(node));
+	node->inv->at[loc].push_back(node);
+	_alive[node->id] = node;
+	_worklist.push_back(node->id);
+	return node;
+}
+
+void LazyAbstraction::expand(ArtNode* node) {
+	const ast::FunDef* fun = node->inv->fun;
+	const ast::FlowGraph& graph = *_flow.at(fun);
+	node->expanded = true;
+
+	if (node->loc == graph.exit()) {
+		add_exit(node);
+		return;
+	}
+
+	z3::expr pre = formula(node->state);
+	for (const ast::FlowGraph::Edge* edge : graph.outgoing(node->loc)) {
+		if (dynamic_cast<const ast::Call*>(edge->stmt)) {
+			expand_call(node, edge);
+			continue;
+		}
+
+		// post = abstraction of { s' | s in node->state, s -> s' }; expressed via wp over the pre state
+		const auto& preds = precision(fun, edge->dst);
+		z3::expr psi = pre && guard(edge->stmt);
+		for (std::size_t p : preds) {
+			std::string name = "lazy$" + std::to_string(p);
+			psi = psi && (_context.bool_const(name.c_str()) == image(edge->stmt, p));
+		}
+
+		State post = abstract(psi, preds);
+		if (!post.empty())
+			add_child(node, edge->dst, post, edge->stmt, NULL);
+	}
+}
+
+void LazyAbstraction::expand_call(ArtNode* node, const ast::FlowGraph::Edge* edge) {
+	const ast::FunDef* callee = dynamic_cast<const ast::Call*>(edge->stmt)->decl();
+	const auto& preds = precision(callee, _flow.at(callee)->entry());
+
+	// entry state: caller state projected to globals; the caller's locals are hidden (recursion)
+	z3::expr psi = rename(formula(node->state), _locals.at(node->inv->fun));
+	for (std::size_t p : preds) {
+		std::string name = "lazy$" + std::to_string(p);
+		psi = psi && (_context.bool_const(name.c_str()) == _preds.at(p)->z3);
+	}
+	State entry = abstract(psi, preds, true);
+	assert(!entry.empty());
+
+	// find or create invocation of callee with the computed entry state
+	Invocation* inv = NULL;
+	for (const auto& i : _invocations)
+		if (i->fun == callee && i->entry == entry)
+			inv = i.get();
+
+	if (inv == NULL) {
+		inv = new Invocation(callee, entry, node->inv->depth + 1);
+		_invocations.push_back(std::unique_ptr<Invocation>(inv));
+		inv->root.reset(new ArtNode(_next_id++, inv, _flow.at(callee)->entry(), entry, NULL, NULL, NULL));
+		inv->at[inv->root->loc].push_back(inv->root.get());
+		_alive[inv->root->id] = inv->root.get();
+		_worklist.push_back(inv->root->id);
+	}
+
+	attach(inv, node, edge);
+}
+
+void LazyAbstraction::add_summary(ArtNode* site, const ast::FlowGraph::Edge* edge, ArtNode* exit) {
+	const ast::FunDef* caller = site->inv->fun;
+	const auto& preds = precision(caller, edge->dst);
+
+	// the callee may change globals but not the caller's locals
+	z3::expr before = rename(formula(site->state), _globals);
+	z3::expr after = rename(formula(exit->state), _locals.at(exit->inv->fun));
+	z3::expr psi = before && after;
+	for (std::size_t p : preds) {
+		std::string name = "lazy$" + std::to_string(p);
+		psi = psi && (_context.bool_const(name.c_str()) == _preds.at(p)->z3);
+	}
+
+	State post = abstract(psi, preds);
+	if (post.empty()) return;
+	ArtNode* node = add_child(site, edge->dst, post, edge->stmt, exit);
+	exit->dependents.push_back(node);
+}
+
+void LazyAbstraction::add_exit(ArtNode* node) {
+	Invocation* inv = node->inv;
+	inv->exits.push_back(node);
+	auto callers = inv->callers;
+	for (const auto& c : callers)
+		add_summary(c.first, c.second, node);
+}
+
+void LazyAbstraction::attach(Invocation* inv, ArtNode* site, const ast::FlowGraph::Edge* edge) {
+	inv->callers.push_back(std::make_pair(site, edge));
+	site->called.push_back(inv);
+
+	if (inv->creator.first == NULL && inv->fun->name() != "main") {
+		// (re-)activate invocation
+		inv->creator = std::make_pair(site, edge);
+		inv->depth = site->inv->depth + 1;
+		for (ArtNode* n : inv->suspended)
+			_worklist.push_back(n->id);
+		for (ArtNode* n : inv->errors)
+			_worklist.push_back(n->id);
+		inv->suspended.clear();
+	}
+
+	auto exits = inv->exits;
+	for (ArtNode* e : exits)
+		add_summary(site, edge, e);
+}
+
+void LazyAbstraction::detach(Invocation* inv, ArtNode* site) {
+	auto& callers = inv->callers;
+	callers.erase(std::remove_if(callers.begin(), callers.end(), [&] (const std::pair<ArtNode*, const ast::FlowGraph::Edge*>& c) { return c.first == site; }), callers.end());
+
+	if (inv->creator.first != site) return;
+	// pick a new creator which does not depend on inv itself
+	inv->creator = std::make_pair<ArtNode*, const ast::FlowGraph::Edge*>(NULL, NULL);
+	for (const auto& c : callers)
+		if (c.first->inv->depth < inv->depth) {
+			inv->creator = c;
+			break;
+		}
+}
+
+bool LazyAbstraction::cover(ArtNode* node) {
+	for (ArtNode* other : node->inv->at.at(node->loc)) {
+		if (other == node || !other->expanded || other->covered_by != NULL) continue;
+		if (!subsumes(other->state, node->state)) continue;
+		node->covered_by = other;
+		other->covering.push_back(node);
+		return true;
+	}
+	return false;
+}
+
+void LazyAbstraction::prune(ArtNode* node) {
+	// subtree and summary edges depending on node
+	while (!node->children.empty())
+		prune(node->children.back().get());
+	while (!node->dependents.empty())
+		prune(node->dependents.back());
+
+	// nodes covered by node need to be explored again
+	for (ArtNode* c : node->covering) {
+		c->covered_by = NULL;
+		_worklist.push_back(c->id);
+	}
+	if (node->covered_by != NULL) erase(node->covered_by->covering, node);
+	if (node->exit != NULL) erase(node->exit->dependents, node);
+	for (Invocation* inv : node->called) detach(inv, node);
+
+	Invocation* inv = node->inv;
+	erase(inv->at.at(node->loc), node);
+	erase(inv->exits, node);
+	erase(inv->errors, node);
+	erase(inv->suspended, node);
+	_alive.erase(node->id);
+
+	// roots are never pruned
+	assert(node->parent != NULL);
+	auto& siblings = node->parent->children;
+	siblings.erase(std::remove_if(siblings.begin(), siblings.end(), [&] (const std::unique_ptr<ArtNode>& n) { return n.get() == node; }), siblings.end());
+}
+
+void LazyAbstraction::reexpand(ArtNode* node) {
+	while (!node->children.empty())
+		prune(node->children.back().get());
+	while (!node->dependents.empty())
+		prune(node->dependents.back());
+	for (Invocation* inv : node->called) detach(inv, node);
+	node->called.clear();
+	erase(node->inv->exits, node);
+
+	node->expanded = false;
+	_worklist.push_back(node->id);
+}
+
+
+/*** Counterexamples ***/
+
+void LazyAbstraction::append_context(const Invocation* inv, std::vector<Step>& path) const {
+	// trace from main's entry to the entry of inv
+	const ArtNode* site = inv->creator.first;
+	if (site == NULL) return;
+	append_context(site->inv, path);
+	append_path(site, path);
+	path.push_back({ inv->creator.second->stmt, inv->root.get() });
+}
+
+void LazyAbstraction::append_path(const ArtNode* node, std::vector<Step>& path) const {
+	// trace from the entry of node's invocation to node; summary edges are expanded
+	std::vector<const ArtNode*> nodes;
+	for (const ArtNode* n = node; n->parent != NULL; n = n->parent)
+		nodes.push_back(n);
+
+	for (auto it = nodes.rbegin(); it != nodes.rend(); it++) {
+		const ArtNode* n = *it;
+		if (n->exit != NULL) {
+			path.push_back({ n->stmt, n->exit->inv->root.get() });
+			append_path(n->exit, path);
+			path.push_back({ &_return, n });
+		} else {
+			path.push_back({ n->stmt, n });
+		}
+	}
+}
+
+bool LazyAbstraction::is_feasible(const std::vector<Step>& path) {
+	std::vector<const ast::TraceableStatement*> trace;
+	for (const Step& s : path) trace.push_back(s.stmt);
+
+	std::vector<ast::Expr*> constraints = compute_constraints(trace);
+	z3::expr conj = _context.bool_val(true);
+	for (ast::Expr* e : constraints) {
+		conj = conj && e->z3(_context);
+		delete e;
+	}
+
+	ast::QueryOrigin origin("spurious check");
+	return !ast::is_taut(_solver, !conj);
+}
+
+
+/*** Refinement ***/
+
+bool LazyAbstraction::add_predicate(Location loc, ast::Expr* atom) {
+	std::unique_ptr<ast::Expr> owner(atom);
+	const ast::FunDef* scope = atom->scope();
+	if (scope != NULL && scope != loc.first) return false;
+
+	z3::expr p = atom->z3(_context);
+	std::stringstream desc;
+	atom->prettyprint(desc);
+	ast::QueryOrigin origin("refinement", "predicate " + desc.str());
+	if (ast::is_taut(_solver, p) || ast::is_taut(_solver, !p)) return false;
+
+	auto& preds = _precision[loc];
+	for (std::size_t id : preds)
+		if (ast::equals(_solver, _preds.at(id)->z3, p))
+			return false;
+
+	std::stringstream key;
+	atom->prettyprint(key);
+	if (_pred_ids.count(key.str()) == 0) {
+		_pred_ids[key.str()] = _preds.size();
+		_preds.push_back(std::unique_ptr<LazyPredicate>(new LazyPredicate(owner.release(), p)));
+	}
+	std::size_t id = _pred_ids.at(key.str());
+
+	/*output*/std::cout << "-- new predicate [" << loc.first->name() << "@" << loc.second << "] ";
+	/*output*/_preds.at(id)->expr->prettyprint(std::cout);
+	/*output*/std::cout << std::endl;
+
+	preds.push_back(id);
+	return true;
+}
+
+bool LazyAbstraction::refine(const std::vector<Step>& path) {
+	std::vector<const ast::TraceableStatement*> trace;
+	for (const Step& s : path) trace.push_back(s.stmt);
+
+	std::vector<ast::Expr*> constraints = compute_constraints(trace);
+	std::vector<ast::Expr*> interpolants = compute_interpolants(_prog, trace, constraints);
+	assert(constraints.size() == interpolants.size() + 1);
+	for (ast::Expr* e : constraints) delete e;
+
+	// interpolant i holds after statement i -> track its atoms at the corresponding location
+	std::set<Location> refined;
+	for (std::size_t i = 0; i < interpolants.size(); i++) {
+		const ArtNode* node = path.at(i).node;
+		Location loc = std::make_pair(node->inv->fun, node->loc);
+
+		std::unique_ptr<ast::Expr> post(interpolants.at(i)->postprocess_interpolant(_prog));
+		delete interpolants.at(i);
+		std::vector<ast::Expr*> atoms;
+		post->collect_potential_predicates(atoms);
+		for (ast::Expr* a : atoms)
+			if (add_predicate(loc, a))
+				refined.insert(loc);
+	}
+	if (refined.empty()) return false;
+
+	// rebuild the ART below the first refined node of every procedure visited by the trace
+	std::vector<std::size_t> targets;
+	const Invocation* segment = NULL;
+	bool handled = false;
+	for (std::size_t i = 0; i < path.size(); i++) {
+		const ArtNode* node = path.at(i).node;
+		if (node->inv != segment) {
+			segment = node->inv;
+			handled = false;
+		}
+		if (handled || refined.count(std::make_pair(node->inv->fun, node->loc)) == 0) continue;
+		handled = true;
+		// the entry node of a procedure is rebuilt from its call site
+		const ArtNode* target = node->parent != NULL ? node->parent : path.at(i-1).node;
+		targets.push_back(target->id);
+	}
+
+	for (std::size_t id : targets)
+		if (_alive.count(id) > 0)
+			reexpand(_alive.at(id));
+
+	// errors that survived need to be rechecked
+	for (const auto& inv : _invocations)
+		for (ArtNode* n : inv->errors)
+			_worklist.push_back(n->id);
+
+	_refinements++;
+	return true;
+}
+
+
+/*** Main Loop ***/
+
+bool LazyAbstraction::has_context(const Invocation* inv) const {
+	for (; inv->creator.first != NULL; inv = inv->creator.first->inv);
+	return inv->fun->name() == "main";
+}
+
+bool LazyAbstraction::run(bool complete) {
+	const ast::FunDef* main = _prog.name2fun().at("main");
+	Invocation* inv = new Invocation(main, { Cube() }, 0);
+	_invocations.push_back(std::unique_ptr<Invocation>(inv));
+	inv->root.reset(new ArtNode(_next_id++, inv, _flow.at(main)->entry(), { Cube() }, NULL, NULL, NULL));
+	inv->at[inv->root->loc].push_back(inv->root.get());
+	_alive[inv->root->id] = inv->root.get();
+	_worklist.push_back(inv->root->id);
+
+	bool correct = true;
+	while (!_worklist.empty()) {
+		std::size_t id = _worklist.front();
+		_worklist.pop_front();
+		if (_alive.count(id) == 0) continue;
+		ArtNode* node = _alive.at(id);
+		if (node->expanded || node->covered_by != NULL) continue;
+
+		// procedures without caller are not explored further
+		// (a complete tree needs them as long as there are callers at all)
+		if (node->inv->creator.first == NULL && node->inv->fun != main && (!complete || node->inv->callers.empty())) {
+			if (std::find(node->inv->suspended.begin(), node->inv->suspended.end(), node) == node->inv->suspended.end())
+				node->inv->suspended.push_back(node);
+			continue;
+		}
+
+		if (node->loc == _flow.at(node->inv->fun)->error()) {
+			if (std::find(node->inv->errors.begin(), node->inv->errors.end(), node) == node->inv->errors.end())
+				node->inv->errors.push_back(node);
+			if (!has_context(node->inv)) continue;
+
+			std::vector<Step> path;
+			append_context(node->inv, path);
+			append_path(node, path);
+
+			/*output*/std::cout << "/**************** BEGIN TRACE ****************/" << std::endl;
+			/*output*/for (const Step& s : path) s.stmt->prettyprint(std::cout, 1);
+			/*output*/std::cout << "/***************** END TRACE *****************/" << std::endl;
+
+			if (is_feasible(path)) {
+				if (!complete) return false;
+				correct = false;
+			} else if (_refinements < _options.refinements && refine(path)) {
+				continue;
+			} else if (!complete) {
+				throw Inconclusive("Refinement did not make any progress.");
+			}
+
+			// error nodes are leaves of a complete tree
+			node->expanded = true;
+			continue;
+		}
+
+		if (cover(node)) continue;
+		expand(node);
+	}
+
+	return correct;
+}
+
+ast::Expr* LazyAbstraction::expression(const State& state) const {
+	ast::Expr* result = NULL;
+	for (const Cube& cube : state) {
+		ast::Expr* conj = NULL;
+		for (const auto& lit : cube) {
+			ast::Expr* p = _preds.at(lit.first)->expr->copy();
+			if (!lit.second) p = new ast::UnaryExpression(ast::log_not, p);
+			conj = conj == NULL ? p : new ast::BinaryExpression(ast::log_and, conj, p);
+		}
+		if (conj == NULL) conj = new ast::Literal(true);
+		result = result == NULL ? conj : new ast::BinaryExpression(ast::log_or, result, conj);
+	}
+	return result == NULL ? new ast::Literal(false) : result;
+}
+
+std::map<Location, ast::Expr*> LazyAbstraction::invariants() const {
+	// union of all abstract states per location; locations without nodes are unreachable
+	std::map<Location, ast::Expr*> result;
+	for (const auto& f : _flow)
+		for (std::size_t loc = 0; loc < f.second->size(); loc++)
+			result[std::make_pair(f.first, loc)] = NULL;
+
+	for (const auto& inv : _invocations) {
+		for (const auto& e : inv->at) {
+			ast::Expr*& disj = result[std::make_pair(inv->fun, e.first)];
+			for (const ArtNode* node : e.second) {
+				ast::Expr* state = expression(node->state);
+				disj = disj == NULL ? state : new ast::BinaryExpression(ast::log_or, disj, state);
+			}
+		}
+	}
+
+	for (auto& e : result)
+		if (e.second == NULL)
+			e.second = new ast::Literal(false);
+	return result;
+}
+
+
+/******************************************************************************
+	Entry Point
+ ******************************************************************************/
+
+bool cegar::prove_lazy(std::string filename, const Options& options) {
+	auto clk_begin = clock();
+
+	std::unique_ptr<ast::Program> program(load_program(filename));
+	program->prettyprint(std::cout);
+
+	LazyAbstraction engine(*program, options);
+	bool correct;
+	try {
+		correct = engine.run();
+	} catch (const Inconclusive& e) {
+		/*output*/std::cout << std::endl;
+		/*output*/std::cout << "   +---------------------------------+" << std::endl;
+		/*output*/std::cout << "   | Sorry, lazy abstraction failed! |" << std::endl;
+		/*output*/std::cout << "   +---------------------------------+" << std::endl;
+		/*output*/std::cout << std::endl;
+		/*output*/std::cout << "Total Time Taken: " << (clock()-clk_begin)/1000/1000.0 << "s" << std::endl;
+		throw;
+	}
+
+	/*output*/std::cout << std::endl;
+	if (correct) {
+		/*output*/std::cout << "   +---------------------------+" << std::endl;
+		/*output*/std::cout << "   | Your programm is CORRECT! |" << std::endl;
+		/*output*/std::cout << "   +---------------------------+" << std::endl;
+	} else {
+		/*output*/std::cout << "   +-------------------------+" << std::endl;
+		/*output*/std::cout << "   | Your programm is WRONG! |" << std::endl;
+		/*output*/std::cout << "   +-------------------------+" << std::endl;
+	}
+	/*output*/std::cout << std::endl;
+	/*output*/std::cout << "Refinements: " << engine.refinements() << "; ART nodes: " << engine.nodes() << std::endl;
+	/*output*/std::cout << "Total Time Taken: " << (clock()-clk_begin)/1000/1000.0 << "s" << std::endl;
+	return correct;
+}
+
+std::map<std::pair<const ast::FunDef*, std::size_t>, ast::Expr*> cegar::compute_invariants(const ast::Program& program, const Options& options) {
+	LazyAbstraction engine(program, options);
+	engine.run(true);
+	return engine.invariants();
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include "ast/ast.hpp"
+#include "cegar/options.hpp"
+
+
+namespace cegar {
+
+
+	/**
+	 * @brief Checks a C-like integer program for assertion errors
+	 *        using lazy abstraction with interpolants.
+	 * @details Instead of abstracting the whole program and recomputing
+	 *          its reachable states in every iteration (cf. ```cegar::prove```),
+	 *          an abstract reachability tree (ART) is unwound over the
+	 *          FlowGraph of the concrete program:
+	 *          1. every node of the ART is labeled with a location and an
+	 *             abstract state, i.e. a disjunction of cubes over the
+	 *             predicates tracked at that location
+	 *          2. successors are computed on demand; a node is not expanded
+	 *             if its state is subsumed by another node at the same
+	 *             location (covering)
+	 *          3. calls are handled by summaries: every procedure is unwound
+	 *             once per abstract entry state, its exit states are fed
+	 *             back to all call sites waiting for it
+	 *          4. if an error location is reached, the corresponding trace
+	 *             is checked; a spurious trace yields interpolants which are
+	 *             added as predicates to the locations along the trace only
+	 *          5. only the subtrees below the first refined location of
+	 *             the trace (per procedure) are discarded and rebuilt
+	 *
+	 * @see http://dl.acm.org/citation.cfm?id=964021
+	 * @see ast::FunDef::flow
+	 * @see cegar::compute_interpolants
+	 * @param filename path to a file containing the program to check
+	 * @param options maximal number of refinements
+	 * @return ```true``` if the program is proven correct,
+	 *         ```false``` if the program is proven incorrect.
+	 * @throws Inconclusive if the refinement does not make progress
+	 */
+	bool prove_lazy(std::string filename, const Options& options=Options());
+
+	/**
+	 * @brief Computes location invariants of a program by lazy abstraction.
+	 * @details Builds a complete abstract reachability tree: spurious error traces
+	 *          are used for refinement as long as the budget permits, all other
+	 *          error nodes are kept as leaves. The union of all abstract states at a
+	 *          location over-approximates the concrete states reaching that location.
+	 *          Locations refer to the FlowGraph s computed by ```ast::FunDef::flow```.
+	 *
+	 * @param program a validated program
+	 * @param options maximal number of refinements
+	 * @return a mapping from locations to invariants; ownership should be claimed
+	 */
+	std::map<std::pair<const ast::FunDef*, std::size_t>, ast::Expr*> compute_invariants(const ast::Program& program, const Options& options);
+
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <string>
+#include <stdexcept>
+
+
+namespace cegar {
+
+
+	/**
+	 * @brief Knobs of the verification engines.
+	 * @details Every engine only considers the options relevant to it.
+	 */
+	struct Options {
+		/** @brief [cegar] dynamic variable reordering of the BDD manager */
+		bool reorder = false;
+		/** @brief [cegar] successor computation for newly found configurations only */
+		bool frontier = false;
+		/** @brief [cegar] add whole interpolants as predicates instead of their atoms */
+		bool interpolant_predicates = false;
+		/** @brief [cegar] file to write a certificate to if the program is proven correct; none if empty */
+		std::string certificate;
+		/** @brief [cegar] inline calls of non-recursive functions with at most this many flow graph edges; none if 0 */
+		std::size_t inline_threshold = 0;
+		/** @brief [cegar] compose straight-line code into single CFG transitions (not used if a certificate is requested) */
+		bool large_blocks = false;
+		/** @brief [bmc, kind] maximal unwinding/induction depth */
+		std::size_t bound = 20;
+		/** @brief [lazy, kind] maximal number of refinements (for k-induction: for computing invariants) */
+		std::size_t refinements = 100;
+	};
+
+
+	/**
+	 * @brief Thrown by the engines if they cannot come up with a definitive verdict,
+	 *        e.g. if they give up or exceed their bound.
+	 */
+	class Inconclusive : public std::runtime_error {
+		public:
+			Inconclusive(std::string msg) : std::runtime_error(msg) {}
+	};
+
+
+}
@@ -0,0 +1,165 @@
+#include "cegar/portfolio.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "cegar/cegar.hpp"
+#include "cegar/lazy.hpp"
+#include "cegar/bmc.hpp"
+#include "cegar/kinduction.hpp"
+#include "ast/query_log.hpp"
+
+using namespace cegar;
+
+
+// exit codes of the worker processes
+#define EXIT_CORRECT 10
+#define EXIT_WRONG 11
+#define EXIT_INCONCLUSIVE 12
+#define EXIT_ERROR 13
+
+
+/******************************************************************************
+	Configurations
+ ******************************************************************************/
+
+std::vector<Configuration> cegar::default_portfolio() {
+	Options eager;
+
+	Options tuned;
+	tuned.reorder = true;
+	tuned.frontier = true;
+
+	Options coarse;
+	coarse.interpolant_predicates = true;
+
+	Options bmc;
+	bmc.bound = 50;
+
+	Options kind;
+	kind.refinements = 10;
+
+	return {
+		{ "cegar", "cegar", eager },
+		{ "cegar-sift-frontier", "cegar", tuned },
+		{ "cegar-interpolants", "cegar", coarse },
+		{ "lazy", "lazy", eager },
+		{ "bmc", "bmc", bmc },
+		{ "kind", "kind", kind }
+	};
+}
+
+bool cegar::prove_with(std::string filename, const Configuration& config) {
+	if (config.engine == "cegar") return prove(filename, config.options);
+	else if (config.engine == "lazy") return prove_lazy(filename, config.options);
+	else if (config.engine == "bmc") return prove_bmc(filename, config.options);
+	else if (config.engine == "kind") return prove_kinduction(filename, config.options);
+	else throw std::invalid_argument("Unknown engine '" + config.engine + "'.");
+}
+
+
+/******************************************************************************
+	Portfolio
+ ******************************************************************************/
+
+int run_worker(std::string filename, const Configuration& config) {
+	// discard output; the verdict is reported via the exit code
+	int devnull = open("/dev/null", O_WRONLY);
+	dup2(devnull, STDOUT_FILENO);
+	dup2(devnull, STDERR_FILENO);
+
+	// workers inherit the query log; each one logs to a directory of its own so that files are not overwritten
+	ast::QueryLog& log = ast::QueryLog::instance();
+	if (log.enabled()) log.open(log.directory() + "/" + config.name);
+
+	try {
+		return prove_with(filename, config) ? EXIT_CORRECT : EXIT_WRONG;
+	} catch (const Inconclusive& e) {
+		return EXIT_INCONCLUSIVE;
+	} catch (...) {
+		return EXIT_ERROR;
+	}
+}
+
+std::string describe(int status) {
+	if (WIFSIGNALED(status)) return "crashed (signal " + std::to_string(WTERMSIG(status)) + ")";
+	switch (WEXITSTATUS(status)) {
+		case EXIT_CORRECT: return "CORRECT";
+		case EXIT_WRONG: return "WRONG";
+		case EXIT_INCONCLUSIVE: return "inconclusive";
+		default: return "failed";
+	}
+}
+
+bool cegar::prove_portfolio(std::string filename, const std::vector<Configuration>& configs) {
+	auto clk_begin = std::chrono::steady_clock::now();
+	auto elapsed = [&] () -> double { return std::chrono::duration<double>(std::chrono::steady_clock::now() - clk_begin).count(); };
+
+	// start all configurations; flush first so that buffered output is not duplicated
+	std::cout.flush();
+	std::vector<pid_t> pids;
+	for (const Configuration& config : configs) {
+		pid_t pid = fork();
+		if (pid < 0) throw std::runtime_error("Could not start configuration '" + config.name + "'.");
+		if (pid == 0) _exit(run_worker(filename, config));
+		pids.push_back(pid);
+	}
+
+	// wait for the first definitive verdict
+	std::vector<std::string> results(configs.size(), "killed");
+	std::size_t running = configs.size();
+	int winner = -1;
+	while (running > 0 && winner < 0) {
+		int status;
+		pid_t pid = waitpid(-1, &status, 0);
+		if (pid < 0) break;
+		for (std::size_t i = 0; i < pids.size(); i++) {
+			if (pids.at(i) != pid) continue;
+			results.at(i) = describe(status) + " after " + std::to_string(elapsed()) + "s";
+			if (WIFEXITED(status) && (WEXITSTATUS(status) == EXIT_CORRECT || WEXITSTATUS(status) == EXIT_WRONG))
+				winner = i;
+			pids.at(i) = 0;
+			running--;
+		}
+	}
+
+	// cancel the remaining ones
+	for (pid_t pid : pids) {
+		if (pid == 0) continue;
+		kill(pid, SIGKILL);
+		waitpid(pid, NULL, 0);
+	}
+
+	/*output*/std::cout << std::endl;
+	/*output*/for (std::size_t i = 0; i < configs.size(); i++)
+	/*output*/	std::cout << "   " << configs.at(i).name << ": " << results.at(i) << std::endl;
+	/*output*/std::cout << std::endl;
+
+	if (winner < 0) {
+		/*output*/std::cout << "   +--------------------------+" << std::endl;
+		/*output*/std::cout << "   | Sorry, portfolio failed! |" << std::endl;
+		/*output*/std::cout << "   +--------------------------+" << std::endl;
+		/*output*/std::cout << std::endl;
+		/*output*/std::cout << "Total Time Taken: " << elapsed() << "s" << std::endl;
+		throw Inconclusive("No configuration came up with a verdict.");
+	}
+
+	bool correct = results.at(winner).find("CORRECT") == 0;
+	if (correct) {
+		/*output*/std::cout << "   +---------------------------+" << std::endl;
+		/*output*/std::cout << "   | Your programm is CORRECT! |" << std::endl;
+		/*output*/std::cout << "   +---------------------------+" << std::endl;
+	} else {
+		/*output*/std::cout << "   +-------------------------+" << std::endl;
+		/*output*/std::cout << "   | Your programm is WRONG! |" << std::endl;
+		/*output*/std::cout << "   +-------------------------+" << std::endl;
+	}
+	/*output*/std::cout << std::endl;
+	/*output*/std::cout << "Verdict by: " << configs.at(winner).name << std::endl;
+	/*output*/std::cout << "Total Time Taken: " << elapsed() << "s" << std::endl;
+	return correct;
+}
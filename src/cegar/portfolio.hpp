@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include "cegar/options.hpp"
+
+
+namespace cegar {
+
+
+	/**
+	 * @brief A single entry of a portfolio: an engine together with its options.
+	 */
+	struct Configuration {
+		/** @brief name used for reporting */
+		std::string name;
+		/** @brief one of ```cegar```, ```lazy```, ```bmc``` or ```kind``` */
+		std::string engine;
+		Options options;
+	};
+
+	/**
+	 * @brief Gives a portfolio of diverse configurations:
+	 *        eager abstraction with different BDD, reachability and refinement settings,
+	 *        lazy abstraction, bounded model checking and k-induction.
+	 */
+	std::vector<Configuration> default_portfolio();
+
+	/**
+	 * @brief Checks a C-like integer program for assertion errors by racing
+	 *        several configurations against each other.
+	 * @details Every configuration runs in a process of its own such that Z3 and
+	 *          CUDD state (the latter has global variables) is fully isolated.
+	 *          The first definitive verdict is returned, all other configurations
+	 *          are killed. The output of the configurations is suppressed.
+	 *
+	 * @param filename path to a file containing the program to check
+	 * @param configs the configurations to race
+	 * @return ```true``` if the program is proven correct,
+	 *         ```false``` if the program is proven incorrect.
+	 * @throws Inconclusive if no configuration comes up with a verdict
+	 */
+	bool prove_portfolio(std::string filename, const std::vector<Configuration>& configs);
+
+	/**
+	 * @brief Runs a single configuration in the calling process.
+	 * @see Configuration
+	 */
+	bool prove_with(std::string filename, const Configuration& config);
+
+
+}
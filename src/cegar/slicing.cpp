@@ -0,0 +1,58 @@
+#include <stack>
+#include <algorithm>
+#include "cegar/slicing.hpp"
+
+
+using namespace cegar;
+
+
+std::vector<const ast::TraceableStatement*> cegar::slice_trace(const std::vector<const ast::TraceableStatement*>& trace) {
+	std::vector<const ast::TraceableStatement*> result;
+	if (trace.empty()) return result;
+
+	// the final statement is the violated assertion; it is kept as is
+	result.push_back(trace.back());
+
+	std::set<const ast::VarDef*> relevant;
+	bool seeded = false;
+	// relevant locals of the callers, pushed when passing a return (backwards)
+	std::stack<std::set<const ast::VarDef*>> frames;
+
+	for (std::size_t i = trace.size()-1; i-- > 0;) {
+		const ast::TraceableStatement* stmt = trace.at(i);
+
+		if (!seeded) {
+			// the last assume is the negated assertion condition
+			if (const ast::Assume* assume = dynamic_cast<const ast::Assume*>(stmt)) {
+				assume->expr()->collect_vars(relevant);
+				seeded = true;
+				result.push_back(stmt);
+				continue;
+			}
+		}
+
+		if (dynamic_cast<const ast::Return*>(stmt)) {
+			// only globals flow from the callee to the caller
+			std::set<const ast::VarDef*> locals, globals;
+			for (const auto& e : relevant)
+				(e->function() == NULL ? globals : locals).insert(e);
+			frames.push(locals);
+			relevant = globals;
+		} else if (const ast::Call* call = dynamic_cast<const ast::Call*>(stmt)) {
+			// locals of the callee are fresh on entry
+			for (auto it = relevant.begin(); it != relevant.end();)
+				if ((*it)->function() == call->decl()) it = relevant.erase(it);
+				else ++it;
+			if (!frames.empty()) {
+				relevant.insert(frames.top().begin(), frames.top().end());
+				frames.pop();
+			}
+		}
+
+		if (stmt->slice(relevant))
+			result.push_back(stmt);
+	}
+
+	std::reverse(result.begin(), result.end());
+	return result;
+}
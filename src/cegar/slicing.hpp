@@ -0,0 +1,24 @@
+#pragma once
+
+#include "ast/ast.hpp"
+
+
+namespace cegar {
+
+
+	/**
+	 * @brief Removes statements from a counterexample that cannot influence its failing assertion.
+	 * @details Computes the cone of influence of the last assume (the violated assertion condition)
+	 *          backwards thru the trace: assignments are kept if they define a variable the cone
+	 *          depends on, assumes if they mention such a variable. Locals are tracked per frame,
+	 *          globals across calls and returns. Calls and returns are always kept such that the
+	 *          slice is a well-nested trace again.
+	 *          The constraints of the slice are a subset of the constraints of the trace, i.e. if the
+	 *          slice is infeasible, so is the trace (but not necessarily vice versa).
+	 * @param trace a trace as computed by ```ast::flat_trace```, ending with the violated assert
+	 * @return the statements of the slice in trace order
+	 */
+	std::vector<const ast::TraceableStatement*> slice_trace(const std::vector<const ast::TraceableStatement*>& trace);
+
+
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cassert>
+
+
+/**
+ * Assertions come in two tiers that are selected when configuring the build (```-DCHECKS=none|cheap|all```):
+ *  - cheap checks are plain ```assert``` s; they test structural invariants in (almost) constant time
+ *    and are kept in optimized builds unless ```CHECKS=none```
+ *  - expensive checks are ```assert_expensive``` s; they test semantic properties and may involve
+ *    solver calls or BDD operations; they are enabled with ```CHECKS=all``` (default for Debug builds)
+ * Expensive checks are never evaluated if disabled, but still compiled.
+ */
+#ifndef CHECK_EXPENSIVE
+	#define CHECK_EXPENSIVE 0
+#endif
+
+#define assert_expensive(expr) assert(!CHECK_EXPENSIVE || (expr))
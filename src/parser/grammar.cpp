@@ -191,46 +191,46 @@ rule parser::predicatelist	= *predblock;
 
 #include "parser/ast.hpp"
 
-ast<Boolean>         	ast_boolean      	(boolean);
-ast<Number>          	ast_number       	(number);
-ast<Identifier>      	ast_identifier   	(identifier);
-ast<VarName>         	ast_varname      	(varname);
-ast<FunName>         	ast_funname      	(funname);
-ast<Unknown>         	ast_unknown      	(unknown);
+parserlib::ast<Boolean>         	ast_boolean      	(boolean);
+parserlib::ast<Number>          	ast_number       	(number);
+parserlib::ast<Identifier>      	ast_identifier   	(identifier);
+parserlib::ast<VarName>         	ast_varname      	(varname);
+parserlib::ast<FunName>         	ast_funname      	(funname);
+parserlib::ast<Unknown>         	ast_unknown      	(unknown);
                      	                 									
-ast<LogicalNot>      	log_not_expr_ast 	(logical_not_expr);
-ast<ArithmeticalNeg> 	negative_expr_ast	(negative_expr);
-ast<ArithmeticalMult>	mul_expr_ast     	(mul_op);
-ast<ArithmeticalMult>	div_expr_ast     	(div_op);
-ast<ArithmeticalAdd> 	add_expr_ast     	(add_op);
-ast<ArithmeticalSub> 	sub_expr_ast     	(sub_op);
-ast<ComparisonEq>    	eq_op_expr_ast   	(eq_op);
-ast<ComparisonNeq>   	neq_op_expr_ast  	(neq_op);
-ast<ComparisonLt>    	lt_op_expr_ast   	(lt_op);
-ast<ComparisonLte>   	lte_op_expr_ast  	(lte_op);
-ast<ComparisonGt>    	gt_op_expr_ast   	(gt_op);
-ast<ComparisonGte>   	gte_op_expr_ast  	(gte_op);
-ast<LogicalAnd>      	log_and_expr_ast 	(log_and_op);
-ast<LogicalOr>       	log_or_expr_ast  	(log_or_op);
+parserlib::ast<LogicalNot>      	log_not_expr_ast 	(logical_not_expr);
+parserlib::ast<ArithmeticalNeg> 	negative_expr_ast	(negative_expr);
+parserlib::ast<ArithmeticalMult>	mul_expr_ast     	(mul_op);
+parserlib::ast<ArithmeticalMult>	div_expr_ast     	(div_op);
+parserlib::ast<ArithmeticalAdd> 	add_expr_ast     	(add_op);
+parserlib::ast<ArithmeticalSub> 	sub_expr_ast     	(sub_op);
+parserlib::ast<ComparisonEq>    	eq_op_expr_ast   	(eq_op);
+parserlib::ast<ComparisonNeq>   	neq_op_expr_ast  	(neq_op);
+parserlib::ast<ComparisonLt>    	lt_op_expr_ast   	(lt_op);
+parserlib::ast<ComparisonLte>   	lte_op_expr_ast  	(lte_op);
+parserlib::ast<ComparisonGt>    	gt_op_expr_ast   	(gt_op);
+parserlib::ast<ComparisonGte>   	gte_op_expr_ast  	(gte_op);
+parserlib::ast<LogicalAnd>      	log_and_expr_ast 	(log_and_op);
+parserlib::ast<LogicalOr>       	log_or_expr_ast  	(log_or_op);
                      	                 																								
-ast<IfThen>          	ast_it           	(it);
-ast<IfThenElse>      	ast_ite          	(ite);
-ast<ElseSeparator>   	ast_elz          	(elz);
-ast<While>           	ast_whl          	(whl);
-ast<Call>            	ast_fun          	(fun);
-ast<AssignSeparator> 	ast_eqsep        	(eqsep);
-ast<Assignment>      	ast_ass          	(ass);
-ast<Assume>          	ast_azzume       	(azzume);
-ast<Assert>          	ast_azzert       	(azzert);
-ast<Skip>            	ast_skipp        	(skipp);
+parserlib::ast<IfThen>          	ast_it           	(it);
+parserlib::ast<IfThenElse>      	ast_ite          	(ite);
+parserlib::ast<ElseSeparator>   	ast_elz          	(elz);
+parserlib::ast<While>           	ast_whl          	(whl);
+parserlib::ast<Call>            	ast_fun          	(fun);
+parserlib::ast<AssignSeparator> 	ast_eqsep        	(eqsep);
+parserlib::ast<Assignment>      	ast_ass          	(ass);
+parserlib::ast<Assume>          	ast_azzume       	(azzume);
+parserlib::ast<Assert>          	ast_azzert       	(azzert);
+parserlib::ast<Skip>            	ast_skipp        	(skipp);
                      	                 																								
-ast<IntType>         	ast_type_int     	(type_int);
-ast<BoolType>        	ast_type_bool    	(type_bool);
+parserlib::ast<IntType>         	ast_type_int     	(type_int);
+parserlib::ast<BoolType>        	ast_type_bool    	(type_bool);
                      	                 																								
-ast<VarDef>          	ast_vardef       	(vardef);
-ast<FunDef>          	ast_fundef       	(fundef);
-ast<Program>         	ast_program      	(program);
+parserlib::ast<VarDef>          	ast_vardef       	(vardef);
+parserlib::ast<FunDef>          	ast_fundef       	(fundef);
+parserlib::ast<Program>         	ast_program      	(program);
                      	                 	
-ast<Predicate>       	ast_pred         	(pred);
-ast<PredicateBlock>  	ast_predblock    	(predblock);
-ast<PredicateList>   	ast_predicatelist	(predicatelist);
+parserlib::ast<Predicate>       	ast_pred         	(pred);
+parserlib::ast<PredicateBlock>  	ast_predblock    	(predblock);
+parserlib::ast<PredicateList>   	ast_predicatelist	(predicatelist);
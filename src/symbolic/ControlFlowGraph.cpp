@@ -1,4 +1,5 @@
 #include "symbolic/ControlFlowGraph.hpp"
+#include "checks.hpp"
 
 using namespace symbolic;
 
@@ -118,7 +119,7 @@ BDD ControlFlowGraph::encode(Node node, bool primed) const {
 
 /*** ControlFlowGraph::publics ***/
 
-ControlFlowGraph::ControlFlowGraph(std::size_t numMainBlocks, std::size_t numBlocks, std::size_t numProcedures, std::size_t numCalls, std::size_t numGlobalVariables, std::size_t numLocalVariables) :
+ControlFlowGraph::ControlFlowGraph(std::size_t numMainBlocks, std::size_t numBlocks, std::size_t numProcedures, std::size_t numCalls, std::size_t numGlobalVariables, std::size_t numLocalVariables, bool composable) :
 	_numMainBlocks(numMainBlocks),
 	_numBlocks(numBlocks),
 	_numProcedures(numProcedures),
@@ -127,14 +128,16 @@ ControlFlowGraph::ControlFlowGraph(std::size_t numMainBlocks, std::size_t numBlo
 	_numGlobVars(numGlobalVariables),
 	_numTempVars(numLocalVariables),
 	_numPVars(_numGlobVars + _numTempVars),
+	_numIntermediateVars(composable ? _numPVars : 0),
+	_composable(composable),
 	_offsetPrime(_numNodeVariables + _numPVars),
 	_offsetRel(2*_offsetPrime),
-	_mgr(Cudd(2*_numNodeVariables + 2*_numPVars + _numGlobVars, 0)),
+	_mgr(Cudd(2*_numNodeVariables + 2*_numPVars + _numGlobVars + _numIntermediateVars, 0)),
 	_trans(_mgr.bddZero()),
 	_calls(_mgr.bddZero()),
 	_exits(_mgr.bddZero()),
 	_returns(_mgr.bddZero()),
-	_vars(init_vars(_mgr, 2*_numNodeVariables + 2*_numPVars + _numGlobVars)),
+	_vars(init_vars(_mgr, 2*_numNodeVariables + 2*_numPVars + _numGlobVars + _numIntermediateVars)),
 	_stateVars(init_varSubset(_vars, 0, _numNodeVariables)),
 	_stateVarsPrimed(init_varSubset(_vars, _offsetPrime, _numNodeVariables)),
 	_programVars(init_varSubset(_vars, _numNodeVariables, _numPVars)),
@@ -143,7 +146,8 @@ ControlFlowGraph::ControlFlowGraph(std::size_t numMainBlocks, std::size_t numBlo
 	_globalVarsPrimed(init_varSubset(_programVarsPrimed, 0, _numGlobVars)),
 	_globalVarsRel(init_varSubset(_vars, _offsetRel, _numGlobVars)),
 	_localVars(init_varSubset(_programVars, _numGlobVars, _numTempVars)),
-	_localVarsPrimed(init_varSubset(_programVarsPrimed, _numGlobVars, _numTempVars))
+	_localVarsPrimed(init_varSubset(_programVarsPrimed, _numGlobVars, _numTempVars)),
+	_programVarsIntermediate(init_varSubset(_vars, _offsetRel + _numGlobVars, _numIntermediateVars))
 {
 	// init prototypes for state encoding
 	_stateProto = one();
@@ -167,6 +171,7 @@ ControlFlowGraph::ControlFlowGraph(std::size_t numMainBlocks, std::size_t numBlo
 	assert(_globalVarsRel.size() == _numGlobVars);
 	assert(_localVars.size() == _numTempVars);
 	assert(_localVarsPrimed.size() == _numTempVars);
+	assert(_programVarsIntermediate.size() == _numIntermediateVars);
 
 	/*output*///std::cout << "ControlFlowGraph created; _numGlobVars:" << _numGlobVars << "; _numTempVars: " << _numTempVars << std::endl;
 }
@@ -180,13 +185,21 @@ void ControlFlowGraph::addTransition(Node src, Node dst, BDD guardedaction) {
 }
 
 void ControlFlowGraph::addCall(Call call, Procedure proc) {
-	assert((_calls * encode(call.call())).IsZero());
+	assert_expensive((_calls * encode(call.call())).IsZero());
 	/*output*///std::cout << "-- adding call: " << call.call().tostr() << " -> " << proc.entry().tostr() << std::endl;
 
 	_calls += encode(call.call()) * encode(proc.entry(), true);
 	_exits += encode(proc.exit()) * encode(call.call(), true);
 }
 
+BDD ControlFlowGraph::compose(BDD first, BDD second) const {
+	assert(_programVarsIntermediate.size() == _numPVars);
+	// first: x -> x' becomes x -> x~, second: x -> x' becomes x~ -> x'
+	BDD pre = first.SwapVariables(_programVarsPrimed, _programVarsIntermediate);
+	BDD post = second.SwapVariables(_programVars, _programVarsIntermediate);
+	return pre.AndAbstract(post, multiply(one(), {_programVarsIntermediate}));
+}
+
 symbolic::Node ControlFlowGraph::decode(BDD state) const {
 	// compute index from BDD
 	std::size_t index = 0;
@@ -27,15 +27,19 @@ namespace symbolic {
 	enum StateType { MAIN, BLOCK, CALL, RETURN, ENTRY, EXIT };
 
 	/**
-	 * @brief Immutable class capturing a node of a control flow graph.
+	 * @brief Value class capturing a node of a control flow graph.
 	 * @details This class is an abstract, more verbose notation for
 	 * dealing with nodes of control flow graphs which have an id and
 	 * a type. It is also independent of an actual '''ControlFlowGraph'''
 	 * instance.
+	 * 
+	 * Nodes are assignable such that statements can hold them by value;
+	 * a default constructed node is a placeholder until a CFG pass assigns it.
 	 */
 	struct Node {
-		const StateType type;
-		const std::size_t id;
+		StateType type;
+		std::size_t id;
+		Node() : type(BLOCK), id(0) {}
 		Node(StateType type, std::size_t id) : type(type), id(id) {}
 		bool is(StateType t) const { return type == t; }
 		std::string tostr() const;
@@ -55,14 +59,16 @@ namespace symbolic {
 	typedef BaseBlock<MAIN> Main;
 
 	struct Call {
-		const std::size_t id;
+		std::size_t id;
+		Call() : id(0) {}
 		Call(std::size_t id) : id(id) {}
 		Node call() const { return Node(CALL, id); }
 		Node retrn() const { return Node(RETURN, id); }
 	};
 
 	struct Procedure {
-		const std::size_t id;
+		std::size_t id;
+		Procedure() : id(0) {}
 		Procedure(std::size_t id) : id(id) {};
 		Node entry() const { return Node(ENTRY, id); }
 		Node exit() const { return Node(EXIT, id); }
@@ -139,6 +145,7 @@ namespace symbolic {
 	 * 3. primed variables
 	 * 4. primed program variables
 	 * 5. doubly primed program variables ("memory" for summary relation)
+	 * 6. intermediate program variables (for composing guarded actions; optional)
 	 */
 	class ControlFlowGraph {
 		private:
@@ -150,6 +157,8 @@ namespace symbolic {
 			const std::size_t _numGlobVars;
 			const std::size_t _numTempVars;
 			const std::size_t _numPVars;
+			const std::size_t _numIntermediateVars;
+			const bool _composable;
 
 			const std::size_t _offsetPrime;
 			const std::size_t _offsetRel;
@@ -171,6 +180,7 @@ namespace symbolic {
 			const std::vector<BDD> _globalVarsRel;
 			const std::vector<BDD> _localVars;
 			const std::vector<BDD> _localVarsPrimed;
+			const std::vector<BDD> _programVarsIntermediate;
 			
 			BDD _stateProto;
 			BDD _stateProtoPrimed;
@@ -184,7 +194,12 @@ namespace symbolic {
 			BDD encode(Node node, bool primed) const;
 
 		public:
-			ControlFlowGraph(std::size_t numMainBlocks, std::size_t numBlocks, std::size_t numProcedures, std::size_t numCalls, std::size_t numGlobalVariables, std::size_t numLocalVariables);
+			/**
+			 * @param numLocalVariables number of local variables of the largest frame; the procedures share them
+			 * @param composable flag determining whether intermediate variables are created,
+			 *        which ```ControlFlowGraph::compose``` requires
+			 */
+			ControlFlowGraph(std::size_t numMainBlocks, std::size_t numBlocks, std::size_t numProcedures, std::size_t numCalls, std::size_t numGlobalVariables, std::size_t numLocalVariables, bool composable=false);
 
 			BDD one() const { return _mgr.bddOne(); }
 			BDD zero() const { return _mgr.bddZero(); }
@@ -194,6 +209,14 @@ namespace symbolic {
 			void addTransition(Node src, Node dst, BDD guardedaction);
 			void addCall(Call call, Procedure proc);
 
+			/**
+			 * @brief Computes the guarded action of executing ```first``` and then ```second```.
+			 * @details Both are relations over program variables and primed program variables.
+			 *          The result is their relational product, i.e. the intermediate valuation
+			 *          is quantified away. Requires a composable ControlFlowGraph.
+			 */
+			BDD compose(BDD first, BDD second) const;
+
 			const std::vector<BDD>& variables() const { return _vars; }
 			const std::vector<BDD>& stateVariables() const { return _stateVars; }
 			const std::vector<BDD>& stateVariablesPrime() const { return _stateVarsPrimed; }
@@ -204,7 +227,9 @@ namespace symbolic {
 			const std::vector<BDD>& globalVariablesRel() const { return _globalVarsRel; }
 			const std::vector<BDD>& localVariables() const { return _localVars; }
 			const std::vector<BDD>& localVariablesPrime() const { return _localVarsPrimed; }
+			const std::vector<BDD>& programVariablesIntermediate() const { return _programVarsIntermediate; }
 
+			bool composable() const { return _composable; }
 			std::size_t number_of_mains() const { return _numMainBlocks; }
 			std::size_t number_of_blocks() const { return _numBlocks; }
 			std::size_t number_of_procedures() const { return _numProcedures; }
@@ -213,8 +238,13 @@ namespace symbolic {
 			BDD encode(Node node) const { return encode(node, false); }
 			symbolic::Node decode(BDD state) const;
 
+			/**
+			 * @brief Enables dynamic variable reordering (sifting) of the underlying BDD manager.
+			 */
+			void enableReordering() const { _mgr.AutodynEnable(CUDD_REORDER_SIFT); }
+
 
-			friend BDD reachable(ControlFlowGraph& cfg, BDD init, BDD bad, bool init_call_frame);
+			friend BDD reachable(ControlFlowGraph& cfg, BDD init, BDD bad, bool init_call_frame, bool frontier, BDD* relation);
 	};
 
 
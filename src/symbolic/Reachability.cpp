@@ -1,4 +1,5 @@
 #include "symbolic/Reachability.hpp"
+#include "checks.hpp"
 
 using namespace symbolic;
 
@@ -32,7 +33,7 @@ BDD symbolic::reachable(const StateTransitionSystem& sts, BDD reachable) {
 
 
 
-BDD symbolic::reachable(ControlFlowGraph& cfg, const BDD init, const BDD bad, const bool init_call_frame) {
+BDD symbolic::reachable(ControlFlowGraph& cfg, const BDD init, const BDD bad, const bool init_call_frame, const bool frontier, BDD* relation) {
 	/* TODO: Rel0
 	 * Currently we use Rel0 := id * val.
 	 * Maybe we should use Rel0 := id * Cofactor(val) to
@@ -42,8 +43,8 @@ BDD symbolic::reachable(ControlFlowGraph& cfg, const BDD init, const BDD bad, co
 	 * of the procedure summary analysis.
 	 */
 
-	BDD reach = init, prevreach;
-	BDD sum = cfg.zero(), prevsum;
+	BDD reach = init, prevreach, front;
+	BDD sum = cfg.zero(), prevsum, sumfront;
 	BDD trans = cfg._trans, prevtrans;
 
 	// precompute initial relation: identity on globals, i.e val(g) <-> mem(g)
@@ -65,9 +66,9 @@ BDD symbolic::reachable(ControlFlowGraph& cfg, const BDD init, const BDD bad, co
 	const BDD state_and_loc_and_rel = multiply(cfg.one(), {cfg._stateVars, cfg._localVars, cfg._globalVarsRel});
 
 	// a priori compute vectors for composition
-	const std::vector<BDD> unprime_state_and_pvar = concat({cfg._stateVars, cfg._programVars, cfg._stateVars, cfg._programVars, cfg._globalVarsRel});
-	const std::vector<BDD> unprime_state_and_memorize_glob = concat({cfg._stateVars, cfg._globalVarsRel, cfg._localVars, cfg._stateVars, cfg._programVarsPrimed, cfg._globalVarsRel}); // s' -> s, g -> g''
-	const std::vector<BDD> unprime_state_and_rel_to_guardedaction = concat({cfg._stateVars, cfg._programVarsPrimed, cfg._stateVars, cfg._programVarsPrimed, cfg._globalVars});
+	const std::vector<BDD> unprime_state_and_pvar = concat({cfg._stateVars, cfg._programVars, cfg._stateVars, cfg._programVars, cfg._globalVarsRel, cfg._programVarsIntermediate});
+	const std::vector<BDD> unprime_state_and_memorize_glob = concat({cfg._stateVars, cfg._globalVarsRel, cfg._localVars, cfg._stateVars, cfg._programVarsPrimed, cfg._globalVarsRel, cfg._programVarsIntermediate}); // s' -> s, g -> g''
+	const std::vector<BDD> unprime_state_and_rel_to_guardedaction = concat({cfg._stateVars, cfg._programVarsPrimed, cfg._stateVars, cfg._programVarsPrimed, cfg._globalVars, cfg._programVarsIntermediate});
 
 	assert(unprime_state_and_pvar.size() == cfg._vars.size());
 	assert(unprime_state_and_memorize_glob.size() == cfg._vars.size());
@@ -78,6 +79,7 @@ BDD symbolic::reachable(ControlFlowGraph& cfg, const BDD init, const BDD bad, co
 	auto sum_bad = [&] () -> bool { return ((sum & bad) != cfg.zero()); };
 	auto mk_return = [&] () -> BDD {
 		cfg._trans = trans;
+		if (relation != NULL) *relation = sum;
 		return (reach | sum).ExistAbstract(multiply(cfg.one(), {cfg._globalVarsRel}));
 	};
 
@@ -87,12 +89,14 @@ BDD symbolic::reachable(ControlFlowGraph& cfg, const BDD init, const BDD bad, co
 		/*output*///std::cout << "-- Iteration --" << std::endl;
 
 		// regular reachability analysis: find all configuration reachable
+		front = reach;
 		do {
 			/*output*///std::cout << "\t- Reach" << std::endl;
 			prevreach = reach;
 			// follow transition relation (successor computation)
-			reach += (reach * trans).ExistAbstract(state_and_pvar).VectorCompose(unprime_state_and_pvar);
+			reach += ((frontier ? front : reach) * trans).ExistAbstract(state_and_pvar).VectorCompose(unprime_state_and_pvar);
 			if (reach_bad()) return mk_return();
+			front = reach * !prevreach;
 		} while (reach != prevreach);
 
 		// follow calls from reachability analysis (calls from summary procedures are dealt with below)
@@ -104,16 +108,19 @@ BDD symbolic::reachable(ControlFlowGraph& cfg, const BDD init, const BDD bad, co
 		summaryEdgeAdded = false;
 		do {
 			/*output*///std::cout << "\t- Edge" << std::endl;
+			sumfront = sum;
 			do {
 				/*output*///std::cout << "\t\t- Proc" << std::endl;
 				prevsum = sum;
 				// follow transition relation (successor computation)
-				sum += (sum * trans).ExistAbstract(state_and_pvar).VectorCompose(unprime_state_and_pvar);
+				sum += ((frontier ? sumfront : sum) * trans).ExistAbstract(state_and_pvar).VectorCompose(unprime_state_and_pvar);
 				if (sum_bad()) return mk_return();
+				sumfront = sum * !prevsum;
 				if (sum != prevsum) continue;
 				// follow procedure calls (call valuation: x')
 				sum += (sum * cfg._calls).ExistAbstract(state_and_loc_and_rel).VectorCompose(unprime_state_and_memorize_glob) * rel0;
 				if (sum_bad()) return mk_return();
+				sumfront = sum * !prevsum;
 			} while (sum != prevsum);
 
 			// add summary edges
@@ -132,15 +139,15 @@ BDD symbolic::reachable(ControlFlowGraph& cfg, const BDD init, const BDD bad, co
 
 std::vector<BDD> symbolic::find_path(const ControlFlowGraph& cfg, const BDD src, const BDD dst, const BDD reach, const BDD ignored_edges) {
 	// TODO: revisit code documentation
-	assert(src & reach != cfg.zero());
-	assert(dst & reach != cfg.zero());
+	assert_expensive((src & reach) != cfg.zero());
+	assert_expensive((dst & reach) != cfg.zero());
 
 	// precompute some stuff
 	const BDD trans = (cfg.transitionRelation() | cfg.callRelation()) & !ignored_edges;
 	const BDD pre_quantifier = multiply(cfg.one(), {cfg.stateVariablesPrime(), cfg.programVariablesPrime()});
 	const BDD post_quantifier = multiply(cfg.one(), {cfg.stateVariables(), cfg.programVariables()});
-	const std::vector<BDD> pre_replace = concat({cfg.stateVariablesPrime(), cfg.programVariablesPrime(), cfg.stateVariablesPrime(), cfg.programVariablesPrime(), cfg.globalVariablesRel()});;
-	const std::vector<BDD> post_replace = concat({cfg.stateVariables(), cfg.programVariables(), cfg.stateVariables(), cfg.programVariables(), cfg.globalVariablesRel()});
+	const std::vector<BDD> pre_replace = concat({cfg.stateVariablesPrime(), cfg.programVariablesPrime(), cfg.stateVariablesPrime(), cfg.programVariablesPrime(), cfg.globalVariablesRel(), cfg.programVariablesIntermediate()});
+	const std::vector<BDD> post_replace = concat({cfg.stateVariables(), cfg.programVariables(), cfg.stateVariables(), cfg.programVariables(), cfg.globalVariablesRel(), cfg.programVariablesIntermediate()});
 	const std::vector<BDD> mintermvars = concat({cfg.stateVariables(), cfg.programVariables()});
 
 	// inline functions to allow reuse of precomputed enteties
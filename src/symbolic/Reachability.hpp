@@ -93,10 +93,16 @@ namespace symbolic {
 	 * @param init the initial configuration
 	 * @param init_call_frame flag determining wheter locla variables are initialized
 	 *        to ```false```
+	 * @param frontier flag determining whether successors are computed for the
+	 *        configurations found in the previous step only (instead of all
+	 *        configurations found so far)
+	 * @param relation if not ```NULL```, receives the configurations explored inside of
+	 *        procedures together with the valuation of the global variables on entry
+	 *        of the procedure (doubly primed variables)
 	 * @return a BDD implementing the characteristic formula of the reachable
 	 *         configurations
 	 */
-	BDD reachable(ControlFlowGraph& cfg, const BDD init, const BDD bad, const bool init_call_frame=false);
+	BDD reachable(ControlFlowGraph& cfg, const BDD init, const BDD bad, const bool init_call_frame=false, const bool frontier=false, BDD* relation=NULL);
 
 
 
@@ -0,0 +1,92 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "z3++.h"
+
+
+#define SLOWEST 10
+
+
+// replays queries recorded with 'RocketScience --log-queries=<dir>' under different solver settings
+
+
+int usage(char* name) {
+	std::cout << std::endl << "ERROR!" << std::endl << "Usage: " << name << " [--param=<name>=<value>]... <query file>..." << std::endl;
+	return 1;
+}
+
+std::string header(const std::string& query, std::string field) {
+	std::string prefix = "; " + field + ": ";
+	std::size_t pos = query.find(prefix);
+	if (pos == std::string::npos) return "";
+	pos += prefix.size();
+	return query.substr(pos, query.find('\n', pos) - pos);
+}
+
+std::string trim(std::string text) {
+	std::size_t begin = text.find_first_not_of(" \n");
+	if (begin == std::string::npos) return "";
+	return text.substr(begin, text.find_last_not_of(" \n") - begin + 1);
+}
+
+struct Replay {
+	std::string file;
+	std::string origin;
+	std::string recorded;
+	std::string replayed;
+	double recorded_time;
+	double replayed_time;
+};
+
+int main(int argc, char *argv[]) {
+	std::vector<std::string> files;
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg.find("--param=") == 0) {
+			std::size_t eq = arg.find('=', 8);
+			if (eq == std::string::npos) return usage(argv[0]);
+			Z3_global_param_set(arg.substr(8, eq-8).c_str(), arg.substr(eq+1).c_str());
+		}
+		else if (arg.find("--") == 0) return usage(argv[0]);
+		else files.push_back(arg);
+	}
+	if (files.empty()) return usage(argv[0]);
+
+	std::vector<Replay> replays;
+	double recorded_total = 0, replayed_total = 0;
+	std::size_t mismatches = 0;
+	for (const std::string& file : files) {
+		std::ifstream in(file);
+		std::stringstream buffer;
+		buffer << in.rdbuf();
+		std::string query = buffer.str();
+
+		Replay replay = { file, header(query, "origin"), header(query, "result"), "", 0, 0 };
+		replay.recorded_time = std::atof(header(query, "time").c_str());
+
+		z3::context context;
+		auto clk_begin = std::chrono::steady_clock::now();
+		replay.replayed = trim(Z3_eval_smtlib2_string(context, query.c_str()));
+		replay.replayed_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - clk_begin).count();
+
+		bool mismatch = replay.recorded != "unknown" && replay.replayed != "unknown" && replay.recorded != replay.replayed;
+		if (mismatch) mismatches++;
+		recorded_total += replay.recorded_time;
+		replayed_total += replay.replayed_time;
+		std::cout << file << " [" << replay.origin << "] " << replay.recorded << " " << replay.recorded_time << "s -> " << replay.replayed << " " << replay.replayed_time << "s" << (mismatch ? " MISMATCH" : "") << std::endl;
+		replays.push_back(replay);
+	}
+
+	std::sort(replays.begin(), replays.end(), [] (const Replay& lhs, const Replay& rhs) { return lhs.replayed_time > rhs.replayed_time; });
+	std::cout << std::endl << "Slowest queries:" << std::endl;
+	for (std::size_t i = 0; i < replays.size() && i < SLOWEST; i++)
+		std::cout << "   " << replays.at(i).replayed_time << "s " << replays.at(i).file << " [" << replays.at(i).origin << "]" << std::endl;
+
+	std::cout << std::endl;
+	std::cout << "Replayed " << replays.size() << " queries: " << recorded_total << "s recorded, " << replayed_total << "s replayed, " << mismatches << " mismatches." << std::endl;
+	return mismatches > 0 ? 1 : 0;
+}
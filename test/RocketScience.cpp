@@ -1,14 +1,76 @@
-
 #include <iostream>
+#include <fstream>
+#include "ast/query_cache.hpp"
+#include "ast/query_log.hpp"
+#include "ast/query_limits.hpp"
 #include "cegar/cegar.hpp"
+#include "cegar/portfolio.hpp"
+#include "cegar/certificate.hpp"
+
 
+#define DEFAULT_BOUND 20
+#define INVARIANT_REFINEMENTS 10
+
+
+int usage(char* name) {
+	std::cout << std::endl << "ERROR!" << std::endl << "Usage: " << name << " [--engine=cegar|lazy|bmc|kind|portfolio] [--bound=<depth>] [--inline=<size>] [--large-blocks] [--certificate=<file>|--check=<file>] [--smt-cache=<file>] [--log-queries=<dir>] [--timeout=<ms>] [--rlimit=<n>] <program file name>" << std::endl;
+	return 1;
+}
 
 int main(int argc, char *argv[]) {
-	if (argc != 2) {
-		std::cout << std::endl << "ERROR!" << std::endl << "Usage: " << argv[0] << " <program file name>" << std::endl;
-		return 1;
+	cegar::Configuration config = { "", "cegar", cegar::Options() };
+	config.options.bound = DEFAULT_BOUND;
+	std::string certfile, cachefile;
+	unsigned int timeout = 0, rlimit = 0;
+	for (int i = 1; i < argc-1; i++) {
+		std::string arg = argv[i];
+		if (arg.find("--engine=") == 0) config.engine = arg.substr(9);
+		else if (arg.find("--bound=") == 0 && arg.size() > 8 && arg.find_first_not_of("0123456789", 8) == std::string::npos) config.options.bound = std::stoul(arg.substr(8));
+		else if (arg.find("--inline=") == 0 && arg.size() > 9 && arg.find_first_not_of("0123456789", 9) == std::string::npos) config.options.inline_threshold = std::stoul(arg.substr(9));
+		else if (arg == "--large-blocks") config.options.large_blocks = true;
+		else if (arg.find("--certificate=") == 0) config.options.certificate = arg.substr(14);
+		else if (arg.find("--check=") == 0) certfile = arg.substr(8);
+		else if (arg.find("--smt-cache=") == 0) cachefile = arg.substr(12);
+		else if (arg.find("--log-queries=") == 0) ast::QueryLog::instance().open(arg.substr(14));
+		else if (arg.find("--timeout=") == 0 && arg.size() > 10 && arg.find_first_not_of("0123456789", 10) == std::string::npos) timeout = std::stoul(arg.substr(10));
+		else if (arg.find("--rlimit=") == 0 && arg.size() > 9 && arg.find_first_not_of("0123456789", 9) == std::string::npos) rlimit = std::stoul(arg.substr(9));
+		else return usage(argv[0]);
+	}
+	if (argc < 2 || (config.engine != "cegar" && config.engine != "lazy" && config.engine != "bmc" && config.engine != "kind" && config.engine != "portfolio")) {
+		return usage(argv[0]);
 	}
+	if (config.engine == "kind") config.options.refinements = INVARIANT_REFINEMENTS;
+
+	std::string progfile = argv[argc-1];
+	if (!certfile.empty()) return cegar::check_certificate(progfile, certfile) ? 0 : 1;
 
-	std::string progfile = argv[1];
-	bool correct = cegar::prove(progfile);
+	ast::QueryLimits& limits = ast::QueryLimits::instance();
+	limits.set(timeout, rlimit);
+
+	ast::QueryCache& cache = ast::QueryCache::instance();
+	if (!cachefile.empty()) {
+		std::ifstream in(cachefile);
+		cache.load(in);
+	}
+
+	int result = 0;
+	try {
+		if (config.engine == "portfolio") cegar::prove_portfolio(progfile, cegar::default_portfolio());
+		else cegar::prove_with(progfile, config);
+	} catch (const cegar::Inconclusive& e) {
+		std::cout << e.what() << std::endl;
+		result = 1;
+	}
+
+	if (cache.hits() + cache.misses() > 0)
+		std::cout << "SMT cache: " << cache.hits() << " hits, " << cache.misses() << " misses." << std::endl;
+	if (!cachefile.empty()) {
+		std::ofstream out(cachefile);
+		cache.save(out);
+	}
+	if (limits.enabled())
+		std::cout << "Solver limits: " << limits.abstraction_fallbacks() << " abstraction fallbacks, " << limits.interpolation_fallbacks() << " interpolation fallbacks." << std::endl;
+	if (ast::QueryLog::instance().enabled())
+		std::cout << "SMT log: " << ast::QueryLog::instance().size() << " queries recorded." << std::endl;
+	return result;
 }
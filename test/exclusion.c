@@ -0,0 +1,28 @@
+int x;
+void main() {
+	x = 0;
+	helper();
+	inc();
+	assert(x < 2);
+}
+void helper() {
+	int k;
+	k = 1;
+	while (k < 3) {
+		k = k + 1;
+	}
+}
+void pure() {
+	int k;
+	k = 1;
+}
+void unused() {
+	while (x > 0) {
+		x = x - 1;
+	}
+	assert(x == 0);
+}
+void inc() {
+	x = x + 1;
+	pure();
+}
@@ -0,0 +1,25 @@
+int g;
+
+void main() {
+	g = 0;
+	mark();
+	twice();
+	assert(g == 2);
+}
+
+void mark() {
+	int seen;
+	if (seen == 0) {
+		g = g + 1;
+	}
+	seen = 1;
+}
+
+void twice() {
+	int t;
+	t = 0;
+	while (t < 1) {
+		mark();
+		t = t + 1;
+	}
+}
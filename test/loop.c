@@ -0,0 +1,8 @@
+int i;
+void main() {
+	i = 0;
+	while (i < 10) {
+		i = i + 1;
+	}
+	assert(i == 10);
+}
@@ -0,0 +1,12 @@
+int i;
+int s;
+
+void main() {
+	i = 0;
+	s = 0;
+	while (i < 3) {
+		i = i + 1;
+		s = s + i;
+	}
+	assert(s != 6);
+}
@@ -0,0 +1,18 @@
+int param;
+int result;
+void main() {
+	param = 3;
+	fun();
+	assert(result > 7);
+}
+void fun() {
+	int local;
+	if (param <= 0) {
+		result = 1;
+	} else {
+		local = param;
+		param = param - 1;
+		fun();
+		result = result + local;
+	}
+}
@@ -0,0 +1,27 @@
+int x;
+int z;
+bool b;
+void main() {
+	int i;
+	int j;
+	x = 0;
+	z = 5;
+	i, j = 1, 2;
+	if (z > 3) {
+		z = z + 1;
+		noise();
+	} else {
+		x = 1;
+	}
+	i = 0;
+	while (i < 2) {
+		i = i + 1;
+		j = j + i;
+	}
+	assert(x < 2);
+}
+void noise() {
+	int k;
+	k = 3;
+	b = k > 2;
+}